@@ -0,0 +1,901 @@
+﻿// ColumnStore.c  | Pylax © 2017 by Thomas Führinger
+// Native row storage for Dynasets: one C array per column, Python objects are only created when data is handed out
+#include "Pylax.h"
+
+#define PxARENA_COMPACT_MIN 65536  // do not bother compacting text arenas holding less garbage than this
+
+static size_t
+PxColumnVector_ItemSize(PxColumnVector* pColumn)
+{
+	switch (pColumn->iKind) {
+	case PxCOLUMN_INTEGER:
+		return sizeof(long long);
+	case PxCOLUMN_REAL:
+		return sizeof(double);
+	case PxCOLUMN_TEXT:
+		return sizeof(PxTextRef);
+	default:
+		return sizeof(PyObject*);
+	}
+}
+
+static void**
+PxColumnVector_Data(PxColumnVector* pColumn)
+// address of the array in use for the column's kind
+{
+	switch (pColumn->iKind) {
+	case PxCOLUMN_INTEGER:
+		return (void**)&pColumn->piData;
+	case PxCOLUMN_REAL:
+		return (void**)&pColumn->pfData;
+	case PxCOLUMN_TEXT:
+		return (void**)&pColumn->pText;
+	default:
+		return (void**)&pColumn->ppyData;
+	}
+}
+
+static PyObject* // new ref
+PxColumnVector_Box(PxColumnVector* pColumn, Py_ssize_t nRow)
+{
+	if (!pColumn->pValid[nRow])
+		Py_RETURN_NONE;
+
+	switch (pColumn->iKind) {
+	case PxCOLUMN_INTEGER:
+		return PyLong_FromLongLong(pColumn->piData[nRow]);
+	case PxCOLUMN_REAL:
+		return PyFloat_FromDouble(pColumn->pfData[nRow]);
+	case PxCOLUMN_TEXT:
+		return PyUnicode_DecodeUTF8(pColumn->sArena + pColumn->pText[nRow].nOffset, (Py_ssize_t)pColumn->pText[nRow].nLength, NULL);
+	default:
+		Py_INCREF(pColumn->ppyData[nRow]);
+		return pColumn->ppyData[nRow];
+	}
+}
+
+static bool
+PxColumnVector_AppendText(PxColumnVector* pColumn, const char* sText, size_t nLength, PxTextRef* pRef)
+{
+	if (pColumn->nArenaUsed + nLength > pColumn->nArenaSize) {
+		size_t nSize = pColumn->nArenaSize ? pColumn->nArenaSize : 1024;
+		while (nSize < pColumn->nArenaUsed + nLength)
+			nSize *= 2;
+		char* sArena = (char*)PyMem_RawRealloc(pColumn->sArena, nSize);
+		if (sArena == NULL) {
+			PyErr_NoMemory();
+			return false;
+		}
+		pColumn->sArena = sArena;
+		pColumn->nArenaSize = nSize;
+	}
+	memcpy(pColumn->sArena + pColumn->nArenaUsed, sText, nLength);
+	pRef->nOffset = pColumn->nArenaUsed;
+	pRef->nLength = nLength;
+	pColumn->nArenaUsed += nLength;
+	return true;
+}
+
+static bool
+PxColumnVector_CompactText(PxColumnVector* pColumn, Py_ssize_t nRows)
+// drop the text of overwritten and deleted cells from the arena
+{
+	size_t nUsed = 0;
+	Py_ssize_t nRow;
+	char* sArena = (char*)PyMem_RawMalloc(pColumn->nArenaUsed - pColumn->nArenaGarbage + 1);
+	if (sArena == NULL) {
+		PyErr_NoMemory();
+		return false;
+	}
+
+	for (nRow = 0; nRow < nRows; nRow++) {
+		if (pColumn->pValid[nRow]) {
+			memcpy(sArena + nUsed, pColumn->sArena + pColumn->pText[nRow].nOffset, pColumn->pText[nRow].nLength);
+			pColumn->pText[nRow].nOffset = nUsed;
+			nUsed += pColumn->pText[nRow].nLength;
+		}
+	}
+	PyMem_RawFree(pColumn->sArena);
+	pColumn->sArena = sArena;
+	pColumn->nArenaSize = pColumn->nArenaUsed - pColumn->nArenaGarbage + 1;
+	pColumn->nArenaUsed = nUsed;
+	pColumn->nArenaGarbage = 0;
+	return true;
+}
+
+static void
+PxColumnVector_Release(PxColumnVector* pColumn, Py_ssize_t nRow)
+// the cell's value is about to be overwritten or removed
+{
+	if (!pColumn->pValid[nRow])
+		return;
+	if (pColumn->iKind == PxCOLUMN_OBJECT)
+		Py_CLEAR(pColumn->ppyData[nRow]);
+	else if (pColumn->iKind == PxCOLUMN_TEXT)
+		pColumn->nArenaGarbage += pColumn->pText[nRow].nLength;
+	pColumn->pValid[nRow] = 0;
+}
+
+static bool
+PxColumnStore_Demote(PxColumnStore* pStore, Py_ssize_t nColumn)
+// a value does not fit the column's kind, so from now on it holds Python objects
+{
+	PxColumnVector* pColumn = pStore->pColumns + nColumn;
+	PyObject** ppyData;
+	Py_ssize_t nRow;
+
+	if (pStore->nExports > 0) {
+		PyErr_SetString(PyExc_BufferError, "Cannot store a value of another type while column buffers are in use.");
+		return false;
+	}
+	if ((ppyData = (PyObject**)PyMem_RawMalloc((pStore->nCapacity ? pStore->nCapacity : 1) * sizeof(PyObject*))) == NULL) {
+		PyErr_NoMemory();
+		return false;
+	}
+	for (nRow = 0; nRow < pStore->nRows; nRow++) {
+		if (pColumn->pValid[nRow]) {
+			if ((ppyData[nRow] = PxColumnVector_Box(pColumn, nRow)) == NULL) {
+				while (--nRow >= 0)
+					Py_XDECREF(ppyData[nRow]);
+				PyMem_RawFree(ppyData);
+				return false;
+			}
+		}
+		else
+			ppyData[nRow] = NULL;
+	}
+
+	PyMem_RawFree(*PxColumnVector_Data(pColumn));
+	*PxColumnVector_Data(pColumn) = NULL;
+	PyMem_RawFree(pColumn->sArena);
+	pColumn->sArena = NULL;
+	pColumn->nArenaUsed = pColumn->nArenaSize = pColumn->nArenaGarbage = 0;
+	pColumn->iKind = PxCOLUMN_OBJECT;
+	pColumn->ppyData = ppyData;
+	return true;
+}
+
+static bool
+PxColumnStore_Store(PxColumnStore* pStore, Py_ssize_t nRow, Py_ssize_t nColumn, PyObject* pyData)
+// the cell must be empty (released)
+{
+	PxColumnVector* pColumn = pStore->pColumns + nColumn;
+	const char* sText;
+	Py_ssize_t nLength;
+	long long iValue;
+	int iOverflow;
+
+	if (pyData == Py_None) {
+		// a defined filler for readers of column buffers that ignore the mask
+		if (pColumn->iKind == PxCOLUMN_INTEGER)
+			pColumn->piData[nRow] = 0;
+		else if (pColumn->iKind == PxCOLUMN_REAL)
+			pColumn->pfData[nRow] = Py_NAN;
+		return true;
+	}
+
+	switch (pColumn->iKind) {
+	case PxCOLUMN_INTEGER:
+		if (PyLong_CheckExact(pyData)) {
+			iValue = PyLong_AsLongLongAndOverflow(pyData, &iOverflow);
+			if (iOverflow == 0) {
+				pColumn->piData[nRow] = iValue;
+				pColumn->pValid[nRow] = 1;
+				return true;
+			}
+		}
+		break;
+	case PxCOLUMN_REAL:
+		if (PyFloat_CheckExact(pyData)) {
+			pColumn->pfData[nRow] = PyFloat_AS_DOUBLE(pyData);
+			pColumn->pValid[nRow] = 1;
+			return true;
+		}
+		break;
+	case PxCOLUMN_TEXT:
+		if (PyUnicode_CheckExact(pyData)) {
+			if ((sText = PyUnicode_AsUTF8AndSize(pyData, &nLength)) == NULL)
+				return false;
+			if (!PxColumnVector_AppendText(pColumn, sText, (size_t)nLength, pColumn->pText + nRow))
+				return false;
+			pColumn->pValid[nRow] = 1;
+			return true;
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (pColumn->iKind != PxCOLUMN_OBJECT && !PxColumnStore_Demote(pStore, nColumn))
+		return false;
+	Py_INCREF(pyData);
+	pColumn->ppyData[nRow] = pyData;
+	pColumn->pValid[nRow] = 1;
+	return true;
+}
+
+static bool
+PxColumnStore_Reserve(PxColumnStore* pStore, Py_ssize_t nRows)
+{
+	Py_ssize_t nCapacity, nColumn;
+	PxColumnVector* pColumn;
+	void* pNew;
+
+	if (nRows <= pStore->nCapacity)
+		return true;
+	if (pStore->nExports > 0) {
+		PyErr_SetString(PyExc_BufferError, "Cannot add rows while column buffers are in use.");
+		return false;
+	}
+	nCapacity = pStore->nCapacity ? pStore->nCapacity : 64;
+	while (nCapacity < nRows)
+		nCapacity *= 2;
+
+	if ((pNew = PyMem_RawRealloc(pStore->pState, nCapacity)) == NULL)
+		goto NOMEMORY;
+	pStore->pState = (unsigned char*)pNew;
+
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		pColumn = pStore->pColumns + nColumn;
+		if ((pNew = PyMem_RawRealloc(*PxColumnVector_Data(pColumn), nCapacity * PxColumnVector_ItemSize(pColumn))) == NULL)
+			goto NOMEMORY;
+		*PxColumnVector_Data(pColumn) = pNew;
+		if ((pNew = PyMem_RawRealloc(pColumn->pValid, nCapacity)) == NULL)
+			goto NOMEMORY;
+		pColumn->pValid = (unsigned char*)pNew;
+	}
+	pStore->nCapacity = nCapacity;
+	return true;
+
+NOMEMORY:
+	PyErr_NoMemory();
+	return false;
+}
+
+PxColumnKind
+PxColumnStore_KindForType(PyObject* pyType)
+{
+	if (pyType == (PyObject*)&PyLong_Type)
+		return PxCOLUMN_INTEGER;
+	if (pyType == (PyObject*)&PyFloat_Type)
+		return PxCOLUMN_REAL;
+	if (pyType == (PyObject*)&PyUnicode_Type)
+		return PxCOLUMN_TEXT;
+	return PxCOLUMN_OBJECT;
+}
+
+PxColumnStore*
+PxColumnStore_New(Py_ssize_t nColumns, const PxColumnKind* pKinds)
+{
+	Py_ssize_t nColumn;
+	PxColumnStore* pStore = (PxColumnStore*)PyMem_RawCalloc(1, sizeof(PxColumnStore));
+	if (pStore == NULL) {
+		PyErr_NoMemory();
+		return NULL;
+	}
+	if ((pStore->pColumns = (PxColumnVector*)PyMem_RawCalloc(nColumns ? nColumns : 1, sizeof(PxColumnVector))) == NULL) {
+		PyMem_RawFree(pStore);
+		PyErr_NoMemory();
+		return NULL;
+	}
+	pStore->nColumns = nColumns;
+	for (nColumn = 0; nColumn < nColumns; nColumn++)
+		pStore->pColumns[nColumn].iKind = pKinds ? pKinds[nColumn] : PxCOLUMN_OBJECT;
+	return pStore;
+}
+
+void
+PxColumnStore_Free(PxColumnStore* pStore)
+{
+	Py_ssize_t nRow, nColumn;
+	PxColumnVector* pColumn;
+
+	if (pStore == NULL)
+		return;
+	if (pStore->nExports > 0) {
+		pStore->bOrphaned = true;
+		return;
+	}
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		pColumn = pStore->pColumns + nColumn;
+		if (pColumn->iKind == PxCOLUMN_OBJECT)
+			for (nRow = 0; nRow < pStore->nRows; nRow++)
+				Py_XDECREF(pColumn->ppyData[nRow]);
+		PyMem_RawFree(*PxColumnVector_Data(pColumn));
+		PyMem_RawFree(pColumn->pValid);
+		PyMem_RawFree(pColumn->sArena);
+	}
+	PyMem_RawFree(pStore->pColumns);
+	PyMem_RawFree(pStore->pState);
+	PyMem_RawFree(pStore);
+}
+
+bool
+PxColumnStore_InsertRow(PxColumnStore* pStore, Py_ssize_t nRow, PyObject* pyRowData, unsigned char cState)
+// insert a row of data (a tuple with an item for each column) before nRow, nRow == nRows appends
+{
+	Py_ssize_t nColumn, nMove;
+	PxColumnVector* pColumn;
+	size_t nSize;
+	char* pData;
+
+	if (PyTuple_Size(pyRowData) != pStore->nColumns) {
+		PyErr_Format(PyExc_ValueError, "Row has %d items, Dynaset has %d columns.", (int)PyTuple_Size(pyRowData), (int)pStore->nColumns);
+		return false;
+	}
+	if (!PxColumnStore_Reserve(pStore, pStore->nRows + 1))
+		return false;
+
+	nMove = pStore->nRows - nRow;
+	if (nMove > 0) {
+		memmove(pStore->pState + nRow + 1, pStore->pState + nRow, nMove);
+		for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+			pColumn = pStore->pColumns + nColumn;
+			nSize = PxColumnVector_ItemSize(pColumn);
+			pData = (char*)*PxColumnVector_Data(pColumn);
+			memmove(pData + (nRow + 1) * nSize, pData + nRow * nSize, nMove * nSize);
+			memmove(pColumn->pValid + nRow + 1, pColumn->pValid + nRow, nMove);
+		}
+	}
+
+	pStore->pState[nRow] = cState;
+	pStore->nRows++;
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		pStore->pColumns[nColumn].pValid[nRow] = 0;
+		if (pStore->pColumns[nColumn].iKind == PxCOLUMN_OBJECT)
+			pStore->pColumns[nColumn].ppyData[nRow] = NULL;
+	}
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		if (!PxColumnStore_Store(pStore, nRow, nColumn, PyTuple_GET_ITEM(pyRowData, nColumn))) {
+			PxColumnStore_DeleteRow(pStore, nRow);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool
+PxColumnStore_AppendStatementRow(PxColumnStore* pStore, PxQuery* pQuery)
+// append the row a query's statement is on, integers, reals and text go into their vectors without a Python object in between
+{
+	sqlite3_stmt* pStmt = pQuery->pStmt;
+	PxColumnVector* pColumn;
+	PyObject* pyData;
+	Py_ssize_t nColumn, nRow = pStore->nRows;
+	const unsigned char* sText;
+	int iType;
+	bool bOk;
+
+	if (!PxColumnStore_Reserve(pStore, nRow + 1))
+		return false;
+	pStore->pState[nRow] = 0;
+	pStore->nRows++;
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		pStore->pColumns[nColumn].pValid[nRow] = 0;
+		if (pStore->pColumns[nColumn].iKind == PxCOLUMN_OBJECT)
+			pStore->pColumns[nColumn].ppyData[nRow] = NULL;
+	}
+
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		pColumn = pStore->pColumns + nColumn;
+		iType = (nColumn < pQuery->nColumns && pQuery->piConverters[nColumn] == -1) ? sqlite3_column_type(pStmt, (int)nColumn) : SQLITE_NULL;
+		if (pColumn->iKind == PxCOLUMN_INTEGER && iType == SQLITE_INTEGER) {
+			pColumn->piData[nRow] = sqlite3_column_int64(pStmt, (int)nColumn);
+			pColumn->pValid[nRow] = 1;
+			continue;
+		}
+		if (pColumn->iKind == PxCOLUMN_REAL && iType == SQLITE_FLOAT) {
+			pColumn->pfData[nRow] = sqlite3_column_double(pStmt, (int)nColumn);
+			pColumn->pValid[nRow] = 1;
+			continue;
+		}
+		if (pColumn->iKind == PxCOLUMN_TEXT && iType == SQLITE_TEXT) {
+			sText = sqlite3_column_text(pStmt, (int)nColumn);
+			if (!PxColumnVector_AppendText(pColumn, sText ? (const char*)sText : "", (size_t)sqlite3_column_bytes(pStmt, (int)nColumn), pColumn->pText + nRow))
+				goto ERROR;
+			pColumn->pValid[nRow] = 1;
+			continue;
+		}
+
+		// NULL, converted or of another kind than the column, computed columns beyond the statement's
+		if (nColumn < pQuery->nColumns)
+			pyData = PxQuery_ColumnValue(pQuery, (int)nColumn);
+		else {
+			Py_INCREF(Py_None);
+			pyData = Py_None;
+		}
+		if (pyData == NULL)
+			goto ERROR;
+		bOk = PxColumnStore_Store(pStore, nRow, nColumn, pyData);
+		Py_DECREF(pyData);
+		if (!bOk)
+			goto ERROR;
+	}
+	return true;
+
+ERROR:
+	PxColumnStore_DeleteRow(pStore, nRow);
+	return false;
+}
+
+bool
+PxColumnStore_DeleteRow(PxColumnStore* pStore, Py_ssize_t nRow)
+{
+	Py_ssize_t nColumn, nMove;
+	PxColumnVector* pColumn;
+	size_t nSize;
+	char* pData;
+
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++)
+		PxColumnVector_Release(pStore->pColumns + nColumn, nRow);
+
+	nMove = pStore->nRows - nRow - 1;
+	if (nMove > 0) {
+		memmove(pStore->pState + nRow, pStore->pState + nRow + 1, nMove);
+		for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+			pColumn = pStore->pColumns + nColumn;
+			nSize = PxColumnVector_ItemSize(pColumn);
+			pData = (char*)*PxColumnVector_Data(pColumn);
+			memmove(pData + nRow * nSize, pData + (nRow + 1) * nSize, nMove * nSize);
+			memmove(pColumn->pValid + nRow, pColumn->pValid + nRow + 1, nMove);
+		}
+	}
+	pStore->nRows--;
+	return true;
+}
+
+static void
+PxColumnStore_Squeeze(char* pData, size_t nSize, const Py_ssize_t* pnRows, Py_ssize_t nCount, Py_ssize_t nRows)
+// close the gaps left by the rows pnRows, moving each run of remaining rows once
+{
+	Py_ssize_t n, nFrom, nTo = pnRows[0], nEnd;
+
+	for (n = 0; n < nCount; n++) {
+		nFrom = pnRows[n] + 1;
+		nEnd = (n + 1 < nCount) ? pnRows[n + 1] : nRows;
+		if (nEnd > nFrom)
+			memmove(pData + nTo * nSize, pData + nFrom * nSize, (nEnd - nFrom) * nSize);
+		nTo += nEnd - nFrom;
+	}
+}
+
+bool
+PxColumnStore_DeleteRows(PxColumnStore* pStore, const Py_ssize_t* pnRows, Py_ssize_t nCount)
+// remove the rows listed in ascending order in a single pass over each array
+{
+	Py_ssize_t n, nColumn;
+	PxColumnVector* pColumn;
+
+	if (nCount == 0)
+		return true;
+	for (n = 0; n < nCount; n++)
+		for (nColumn = 0; nColumn < pStore->nColumns; nColumn++)
+			PxColumnVector_Release(pStore->pColumns + nColumn, pnRows[n]);
+
+	PxColumnStore_Squeeze((char*)pStore->pState, 1, pnRows, nCount, pStore->nRows);
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		pColumn = pStore->pColumns + nColumn;
+		PxColumnStore_Squeeze((char*)*PxColumnVector_Data(pColumn), PxColumnVector_ItemSize(pColumn), pnRows, nCount, pStore->nRows);
+		PxColumnStore_Squeeze((char*)pColumn->pValid, 1, pnRows, nCount, pStore->nRows);
+	}
+	pStore->nRows -= nCount;
+	return true;
+}
+
+static void
+PxColumnStore_Gather(char* pData, char* pScratch, size_t nSize, const Py_ssize_t* pnOrder, Py_ssize_t nRows)
+// reorder an array in place, item n becomes the former item pnOrder[n]
+{
+	Py_ssize_t nRow;
+	for (nRow = 0; nRow < nRows; nRow++)
+		memcpy(pScratch + nRow * nSize, pData + pnOrder[nRow] * nSize, nSize);
+	memcpy(pData, pScratch, nRows * nSize);
+}
+
+bool
+PxColumnStore_Permute(PxColumnStore* pStore, const Py_ssize_t* pnOrder)
+// row n becomes the former row pnOrder[n], text stays where it is in the arenas
+{
+	Py_ssize_t nColumn;
+	PxColumnVector* pColumn;
+	char* pScratch;
+
+	if (pStore->nRows == 0)
+		return true;
+	if ((pScratch = (char*)PyMem_RawMalloc(pStore->nRows * sizeof(PxTextRef))) == NULL) { // the largest item
+		PyErr_NoMemory();
+		return false;
+	}
+	PxColumnStore_Gather((char*)pStore->pState, pScratch, 1, pnOrder, pStore->nRows);
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		pColumn = pStore->pColumns + nColumn;
+		PxColumnStore_Gather((char*)*PxColumnVector_Data(pColumn), pScratch, PxColumnVector_ItemSize(pColumn), pnOrder, pStore->nRows);
+		PxColumnStore_Gather((char*)pColumn->pValid, pScratch, 1, pnOrder, pStore->nRows);
+	}
+	PyMem_RawFree(pScratch);
+	return true;
+}
+
+PyObject* // new ref
+PxColumnStore_GetItem(PxColumnStore* pStore, Py_ssize_t nRow, Py_ssize_t nColumn)
+{
+	if (nRow < 0 || nRow >= pStore->nRows || nColumn < 0 || nColumn >= pStore->nColumns) {
+		PyErr_SetString(PyExc_IndexError, "Cell out of range.");
+		return NULL;
+	}
+	return PxColumnVector_Box(pStore->pColumns + nColumn, nRow);
+}
+
+bool
+PxColumnStore_SetItem(PxColumnStore* pStore, Py_ssize_t nRow, Py_ssize_t nColumn, PyObject* pyData)
+{
+	PxColumnVector* pColumn;
+	PyObject* pyDataOld, *pyType, *pyValue, *pyTraceback;
+	bool bResult;
+
+	// the value before might be the very same object, and goes back in when the new one can not be stored
+	if ((pyDataOld = PxColumnStore_GetItem(pStore, nRow, nColumn)) == NULL)
+		return false;
+	PxColumnVector_Release(pStore->pColumns + nColumn, nRow);
+	if (!(bResult = PxColumnStore_Store(pStore, nRow, nColumn, pyData))) {
+		PyErr_Fetch(&pyType, &pyValue, &pyTraceback);
+		PxColumnVector_Release(pStore->pColumns + nColumn, nRow);
+		PxColumnStore_Store(pStore, nRow, nColumn, pyDataOld);
+		PyErr_Restore(pyType, pyValue, pyTraceback);
+	}
+	Py_DECREF(pyDataOld);
+
+	pColumn = pStore->pColumns + nColumn;
+	if (bResult && pColumn->iKind == PxCOLUMN_TEXT && pColumn->nArenaGarbage > PxARENA_COMPACT_MIN && pColumn->nArenaGarbage > pColumn->nArenaUsed / 2)
+		bResult = PxColumnVector_CompactText(pColumn, pStore->nRows);
+	return bResult;
+}
+
+PyObject* // new ref
+PxColumnStore_GetRowData(PxColumnStore* pStore, Py_ssize_t nRow)
+{
+	Py_ssize_t nColumn;
+	PyObject* pyRowData, *pyData;
+
+	if ((pyRowData = PyTuple_New(pStore->nColumns)) == NULL)
+		return NULL;
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++) {
+		if ((pyData = PxColumnVector_Box(pStore->pColumns + nColumn, nRow)) == NULL) {
+			Py_DECREF(pyRowData);
+			return NULL;
+		}
+		PyTuple_SET_ITEM(pyRowData, nColumn, pyData);
+	}
+	return pyRowData;
+}
+
+bool
+PxColumnStore_SetRowData(PxColumnStore* pStore, Py_ssize_t nRow, PyObject* pyRowData)
+{
+	Py_ssize_t nColumn;
+	for (nColumn = 0; nColumn < pStore->nColumns; nColumn++)
+		if (!PxColumnStore_SetItem(pStore, nRow, nColumn, PyTuple_GET_ITEM(pyRowData, nColumn)))
+			return false;
+	return true;
+}
+
+bool
+PxColumnStore_BindItem(PxColumnStore* pStore, Py_ssize_t nRow, Py_ssize_t nColumn, PxQuery* pQuery, int nParam)
+// bind a cell to a parameter of the query's statement, boxing it only if it holds a Python object
+{
+	PxColumnVector* pColumn = pStore->pColumns + nColumn;
+	int iResult;
+
+	if (!pColumn->pValid[nRow])
+		iResult = sqlite3_bind_null(pQuery->pStmt, nParam);
+	else {
+		switch (pColumn->iKind) {
+		case PxCOLUMN_INTEGER:
+			iResult = sqlite3_bind_int64(pQuery->pStmt, nParam, pColumn->piData[nRow]);
+			break;
+		case PxCOLUMN_REAL:
+			iResult = sqlite3_bind_double(pQuery->pStmt, nParam, pColumn->pfData[nRow]);
+			break;
+		case PxCOLUMN_TEXT:
+			iResult = sqlite3_bind_text(pQuery->pStmt, nParam, pColumn->sArena + pColumn->pText[nRow].nOffset, (int)pColumn->pText[nRow].nLength, SQLITE_TRANSIENT);
+			break;
+		default:
+			return PxQuery_BindValue(pQuery, nParam, pColumn->ppyData[nRow]);
+		}
+	}
+	if (iResult != SQLITE_OK) {
+		PxQuery_SetError(pQuery, iResult);
+		return false;
+	}
+	return true;
+}
+
+// Aggregates
+// The rows are either 0 to nRows - 1 or those listed in pnRows. NULL cells hold 0 or NaN as fillers, every loop masks with pValid so NULLs are skipped rather than counted.
+
+static int
+PxColumnVector_CompareText(const PxColumnVector* pColumn, const PxTextRef* pA, const PxTextRef* pB)
+// code point order, as Python compares str
+{
+	int iResult = memcmp(pColumn->sArena + pA->nOffset, pColumn->sArena + pB->nOffset, pA->nLength < pB->nLength ? pA->nLength : pB->nLength);
+	if (iResult == 0)
+		iResult = (pA->nLength > pB->nLength) - (pA->nLength < pB->nLength);
+	return iResult;
+}
+
+static int
+PxColumnVector_CompareRows(const PxColumnVector* pColumn, Py_ssize_t nRowA, Py_ssize_t nRowB)
+{
+	switch (pColumn->iKind) {
+	case PxCOLUMN_INTEGER:
+		return (pColumn->piData[nRowA] > pColumn->piData[nRowB]) - (pColumn->piData[nRowA] < pColumn->piData[nRowB]);
+	case PxCOLUMN_REAL:
+		return (pColumn->pfData[nRowA] > pColumn->pfData[nRowB]) - (pColumn->pfData[nRowA] < pColumn->pfData[nRowB]);
+	default:
+		return PxColumnVector_CompareText(pColumn, pColumn->pText + nRowA, pColumn->pText + nRowB);
+	}
+}
+
+bool
+PxColumnStore_Summarize(PxColumnStore* pStore, Py_ssize_t nColumn, const Py_ssize_t* pnRows, Py_ssize_t nRows, bool bExtremes, PxColumnSummary* pSummary)
+// count and sum in one pass written to be vectorized, the rows of minimum and maximum in another if bExtremes, not for PxCOLUMN_OBJECT
+{
+	PxColumnVector* pColumn = pStore->pColumns + nColumn;
+	const unsigned char* pValid = pColumn->pValid;
+	const long long* piData = pColumn->piData;
+	const double* pfData = pColumn->pfData;
+	long long iSum = 0, iData;
+	double fSum0 = 0, fSum1 = 0, fSum2 = 0, fSum3 = 0;
+	Py_ssize_t n, nRow, nCount = 0;
+	bool bOverflow = false;
+
+	if (pColumn->iKind == PxCOLUMN_OBJECT)
+		return false;
+
+	if (pnRows == NULL) {
+		for (n = 0; n < nRows; n++)
+			nCount += pValid[n];
+		if (pColumn->iKind == PxCOLUMN_INTEGER) {
+			// as the cell by cell sum, what would overflow goes into the real sum
+			for (n = 0; n < nRows; n++) {
+				iData = piData[n] & -(long long)pValid[n];
+				if ((iData > 0 && iSum > LLONG_MAX - iData) || (iData < 0 && iSum < LLONG_MIN - iData)) {
+					fSum0 += (double)iData;
+					bOverflow = true;
+				}
+				else
+					iSum += iData;
+			}
+		}
+		else if (pColumn->iKind == PxCOLUMN_REAL) {
+			// four partial sums, select instead of multiply so the NaN fillers of NULL cells can not leak in
+			for (n = 0; n + 4 <= nRows; n += 4) {
+				fSum0 += pValid[n] ? pfData[n] : 0.0;
+				fSum1 += pValid[n + 1] ? pfData[n + 1] : 0.0;
+				fSum2 += pValid[n + 2] ? pfData[n + 2] : 0.0;
+				fSum3 += pValid[n + 3] ? pfData[n + 3] : 0.0;
+			}
+			for (; n < nRows; n++)
+				fSum0 += pValid[n] ? pfData[n] : 0.0;
+		}
+	}
+	else {
+		for (n = 0; n < nRows; n++) {
+			nRow = pnRows[n];
+			if (!pValid[nRow])
+				continue;
+			nCount++;
+			if (pColumn->iKind == PxCOLUMN_INTEGER) {
+				iData = piData[nRow];
+				if ((iData > 0 && iSum > LLONG_MAX - iData) || (iData < 0 && iSum < LLONG_MIN - iData)) {
+					fSum0 += (double)iData;
+					bOverflow = true;
+				}
+				else
+					iSum += iData;
+			}
+			else if (pColumn->iKind == PxCOLUMN_REAL)
+				fSum0 += pfData[nRow];
+		}
+	}
+	pSummary->nCount = nCount;
+	pSummary->iSum = iSum;
+	pSummary->bOverflow = bOverflow;
+	pSummary->fSum = (fSum0 + fSum1) + (fSum2 + fSum3);
+	pSummary->nMinRow = pSummary->nMaxRow = -1;
+
+	if (bExtremes) {
+		for (n = 0; n < nRows; n++) {
+			nRow = pnRows ? pnRows[n] : n;
+			if (!pValid[nRow])
+				continue;
+			if (pSummary->nMinRow == -1) {
+				pSummary->nMinRow = pSummary->nMaxRow = nRow;
+				continue;
+			}
+			if (PxColumnVector_CompareRows(pColumn, nRow, pSummary->nMinRow) < 0)
+				pSummary->nMinRow = nRow;
+			else if (PxColumnVector_CompareRows(pColumn, nRow, pSummary->nMaxRow) > 0)
+				pSummary->nMaxRow = nRow;
+		}
+	}
+	return true;
+}
+
+static gint
+PxColumnStore_CompareSlots(gconstpointer pA, gconstpointer pB, gpointer pUserData)
+{
+	PxColumnVector* pColumn = (PxColumnVector*)pUserData;
+	if (pColumn->iKind == PxCOLUMN_INTEGER)
+		return (*(const long long*)pA > *(const long long*)pB) - (*(const long long*)pA < *(const long long*)pB);
+	if (pColumn->iKind == PxCOLUMN_REAL)
+		return (*(const double*)pA > *(const double*)pB) - (*(const double*)pA < *(const double*)pB);
+	return PxColumnVector_CompareText(pColumn, (const PxTextRef*)pA, (const PxTextRef*)pB);
+}
+
+Py_ssize_t
+PxColumnStore_CountDistinct(PxColumnStore* pStore, Py_ssize_t nColumn, const Py_ssize_t* pnRows, Py_ssize_t nRows)
+// number of different values that are not NULL, by sorting a copy, -1 with exception on failure, not for PxCOLUMN_OBJECT
+{
+	PxColumnVector* pColumn = pStore->pColumns + nColumn;
+	size_t nSize = PxColumnVector_ItemSize(pColumn);
+	char* pData = (char*)*PxColumnVector_Data(pColumn), *pCopy;
+	Py_ssize_t n, nRow, nValues = 0, nDistinct = 0;
+
+	if ((pCopy = (char*)PyMem_RawMalloc((nRows ? nRows : 1) * nSize)) == NULL) {
+		PyErr_NoMemory();
+		return -1;
+	}
+	for (n = 0; n < nRows; n++) {
+		nRow = pnRows ? pnRows[n] : n;
+		if (pColumn->pValid[nRow])
+			memcpy(pCopy + nValues++ * nSize, pData + nRow * nSize, nSize);
+	}
+	g_qsort_with_data(pCopy, (gint)nValues, nSize, PxColumnStore_CompareSlots, pColumn);
+	for (n = 0; n < nValues; n++)
+		if (n == 0 || PxColumnStore_CompareSlots(pCopy + (n - 1) * nSize, pCopy + n * nSize, pColumn) != 0)
+			nDistinct++;
+	PyMem_RawFree(pCopy);
+	return nDistinct;
+}
+
+// Column buffers
+// The arrays of INTEGER and REAL columns and their NULL masks exposed through the buffer protocol, so numpy and memoryview read them in place.
+// A column buffer keeps the store alive and from growing, so the arrays stay where they are for as long as anyone may read them.
+
+PyObject* // new ref
+PxColumnBuffer_New(PxColumnStore* pStore, Py_ssize_t nColumn, bool bMask)
+{
+	PxColumnBufferObject* self = PyObject_New(PxColumnBufferObject, &PxColumnBufferType);
+	if (self == NULL)
+		return NULL;
+	self->pStore = pStore;
+	self->nColumn = nColumn;
+	self->bMask = bMask;
+	self->pyValid = NULL;
+	pStore->nExports++;
+	if (!bMask && (self->pyValid = PxColumnBuffer_New(pStore, nColumn, true)) == NULL) {
+		Py_DECREF(self);
+		return NULL;
+	}
+	return (PyObject*)self;
+}
+
+static int
+PxColumnBuffer_getbuffer(PxColumnBufferObject* self, Py_buffer* pView, int iFlags)
+{
+	static char cEmpty;
+	PxColumnVector* pColumn = self->pStore->pColumns + self->nColumn;
+	Py_ssize_t* pnShape;
+
+	if (iFlags & PyBUF_WRITABLE) {
+		PyErr_SetString(PyExc_BufferError, "Column buffers are read-only.");
+		pView->obj = NULL;
+		return -1;
+	}
+	if ((pnShape = (Py_ssize_t*)PyMem_Malloc(sizeof(Py_ssize_t))) == NULL) {
+		PyErr_NoMemory();
+		pView->obj = NULL;
+		return -1;
+	}
+	*pnShape = self->pStore->nRows; // rows deleted meanwhile leave stale items, but within the arrays
+
+	if (self->bMask) {
+		pView->buf = pColumn->pValid;
+		pView->itemsize = 1;
+		pView->format = "?";
+	}
+	else if (pColumn->iKind == PxCOLUMN_INTEGER) {
+		pView->buf = pColumn->piData;
+		pView->itemsize = sizeof(long long);
+		pView->format = "q";
+	}
+	else {
+		pView->buf = pColumn->pfData;
+		pView->itemsize = sizeof(double);
+		pView->format = "d";
+	}
+	if (pView->buf == NULL)
+		pView->buf = &cEmpty; // nothing allocated yet
+	if (!(iFlags & PyBUF_FORMAT))
+		pView->format = NULL;
+	pView->obj = (PyObject*)self;
+	Py_INCREF(self);
+	pView->len = *pnShape * pView->itemsize;
+	pView->readonly = 1;
+	pView->ndim = 1;
+	pView->shape = (iFlags & PyBUF_ND) ? pnShape : NULL;
+	pView->strides = NULL;
+	pView->suboffsets = NULL;
+	pView->internal = pnShape;
+	return 0;
+}
+
+static void
+PxColumnBuffer_releasebuffer(PxColumnBufferObject* self, Py_buffer* pView)
+{
+	PyMem_Free(pView->internal);
+}
+
+static Py_ssize_t
+PxColumnBuffer_length(PxColumnBufferObject* self)
+{
+	return self->pStore->nRows;
+}
+
+static void
+PxColumnBuffer_dealloc(PxColumnBufferObject* self)
+{
+	PxColumnStore* pStore = self->pStore;
+
+	Py_XDECREF(self->pyValid);
+	if (pStore && --pStore->nExports == 0 && pStore->bOrphaned)
+		PxColumnStore_Free(pStore);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyBufferProcs PxColumnBuffer_as_buffer = {
+	(getbufferproc)PxColumnBuffer_getbuffer,
+	(releasebufferproc)PxColumnBuffer_releasebuffer
+};
+
+static PySequenceMethods PxColumnBuffer_as_sequence = {
+	(lenfunc)PxColumnBuffer_length, /* sq_length */
+};
+
+static PyMemberDef PxColumnBuffer_members[] = {
+	{ "valid", T_OBJECT, offsetof(PxColumnBufferObject, pyValid), READONLY, "Buffer of bools over the same rows, False where the cell is NULL. None for a mask itself." },
+	{ NULL }
+};
+
+PyTypeObject PxColumnBufferType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"pylax.ColumnBuffer",      /* tp_name */
+	sizeof(PxColumnBufferObject), /* tp_basicsize */
+	0,                         /* tp_itemsize */
+	(destructor)PxColumnBuffer_dealloc, /* tp_dealloc */
+	0,                         /* tp_print */
+	0,                         /* tp_getattr */
+	0,                         /* tp_setattr */
+	0,                         /* tp_reserved */
+	0,                         /* tp_repr */
+	0,                         /* tp_as_number */
+	&PxColumnBuffer_as_sequence, /* tp_as_sequence */
+	0,                         /* tp_as_mapping */
+	0,                         /* tp_hash  */
+	0,                         /* tp_call */
+	0,                         /* tp_str */
+	0,                         /* tp_getattro */
+	0,                         /* tp_setattro */
+	&PxColumnBuffer_as_buffer, /* tp_as_buffer */
+	Py_TPFLAGS_DEFAULT,        /* tp_flags */
+	"Read-only view of a native Dynaset column, as int64 ('q') or double ('d') items", /* tp_doc */
+	0,                         /* tp_traverse */
+	0,                         /* tp_clear */
+	0,                         /* tp_richcompare */
+	0,                         /* tp_weaklistoffset */
+	0,                         /* tp_iter */
+	0,                         /* tp_iternext */
+	0,                         /* tp_methods */
+	PxColumnBuffer_members,    /* tp_members */
+};
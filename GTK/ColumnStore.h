@@ -0,0 +1,88 @@
+﻿// ColumnStore.h  | Pylax © 2017 by Thomas Führinger
+#ifndef Px_COLUMNSTORE_H
+#define Px_COLUMNSTORE_H
+
+// row state flags, one byte per row
+#define PxROW_NEW       1   // row is still not in database
+#define PxROW_DELETE    2   // row to be removed from the database
+#define PxROW_MODIFIED  4   // row has been edited, data before modification is kept
+
+typedef struct _PxQuery PxQuery;
+
+typedef enum { PxCOLUMN_OBJECT, PxCOLUMN_INTEGER, PxCOLUMN_REAL, PxCOLUMN_TEXT } PxColumnKind;
+
+typedef struct _PxTextRef
+{
+	size_t nOffset;       // position in the column's text arena
+	size_t nLength;       // bytes of UTF-8
+}
+PxTextRef;
+
+typedef struct _PxColumnVector
+{
+	PxColumnKind iKind;
+	long long* piData;    // PxCOLUMN_INTEGER
+	double* pfData;       // PxCOLUMN_REAL
+	PxTextRef* pText;     // PxCOLUMN_TEXT
+	PyObject** ppyData;   // PxCOLUMN_OBJECT, any other type
+	unsigned char* pValid; // 0 if NULL
+	char* sArena;         // UTF-8 text of all cells, back to back
+	size_t nArenaUsed;
+	size_t nArenaSize;
+	size_t nArenaGarbage; // bytes of overwritten text
+}
+PxColumnVector;
+
+typedef struct _PxColumnStore
+{
+	Py_ssize_t nColumns;
+	Py_ssize_t nRows;
+	Py_ssize_t nCapacity;
+	PxColumnVector* pColumns;
+	unsigned char* pState;  // PxROW_ flags
+	Py_ssize_t nExports;    // column buffers over the arrays, which must neither move nor be freed meanwhile
+	bool bOrphaned;         // freed by its owner while still exported, the last column buffer frees it
+}
+PxColumnStore;
+
+typedef struct _PxColumnSummary
+{
+	Py_ssize_t nCount;    // cells that are not NULL
+	long long iSum;       // PxCOLUMN_INTEGER
+	double fSum;          // PxCOLUMN_REAL, and the integers that would overflow iSum
+	bool bOverflow;       // integers have been added to fSum, the sum is fSum + iSum as a real
+	Py_ssize_t nMinRow;   // row holding the smallest value, -1 if all cells are NULL
+	Py_ssize_t nMaxRow;
+}
+PxColumnSummary;
+
+typedef struct _PxColumnBufferObject
+{
+	PyObject_HEAD
+	PxColumnStore* pStore;
+	Py_ssize_t nColumn;
+	bool bMask;           // exposes pValid rather than the values
+	PyObject* pyValid;    // the mask buffer belonging to a buffer of values, NULL for a mask
+}
+PxColumnBufferObject;
+
+extern PyTypeObject PxColumnBufferType;
+
+PxColumnStore* PxColumnStore_New(Py_ssize_t nColumns, const PxColumnKind* pKinds);
+void PxColumnStore_Free(PxColumnStore* pStore);
+PxColumnKind PxColumnStore_KindForType(PyObject* pyType);
+bool PxColumnStore_InsertRow(PxColumnStore* pStore, Py_ssize_t nRow, PyObject* pyRowData, unsigned char cState);
+bool PxColumnStore_AppendStatementRow(PxColumnStore* pStore, PxQuery* pQuery);
+bool PxColumnStore_DeleteRow(PxColumnStore* pStore, Py_ssize_t nRow);
+bool PxColumnStore_DeleteRows(PxColumnStore* pStore, const Py_ssize_t* pnRows, Py_ssize_t nCount);
+bool PxColumnStore_Permute(PxColumnStore* pStore, const Py_ssize_t* pnOrder);
+PyObject* PxColumnStore_GetItem(PxColumnStore* pStore, Py_ssize_t nRow, Py_ssize_t nColumn);
+bool PxColumnStore_SetItem(PxColumnStore* pStore, Py_ssize_t nRow, Py_ssize_t nColumn, PyObject* pyData);
+PyObject* PxColumnStore_GetRowData(PxColumnStore* pStore, Py_ssize_t nRow);
+bool PxColumnStore_Summarize(PxColumnStore* pStore, Py_ssize_t nColumn, const Py_ssize_t* pnRows, Py_ssize_t nRows, bool bExtremes, PxColumnSummary* pSummary);
+Py_ssize_t PxColumnStore_CountDistinct(PxColumnStore* pStore, Py_ssize_t nColumn, const Py_ssize_t* pnRows, Py_ssize_t nRows);
+bool PxColumnStore_SetRowData(PxColumnStore* pStore, Py_ssize_t nRow, PyObject* pyRowData);
+bool PxColumnStore_BindItem(PxColumnStore* pStore, Py_ssize_t nRow, Py_ssize_t nColumn, PxQuery* pQuery, int nParam);
+PyObject* PxColumnBuffer_New(PxColumnStore* pStore, Py_ssize_t nColumn, bool bMask);
+
+#endif
@@ -204,9 +204,12 @@ PxComboBox_refresh(PxComboBoxObject* self)
 		PyObject* pyData = PxWidget_PullData((PxWidgetObject*)self);
 		if (!PyObject_RichCompareBool(self->pyData, pyData, Py_EQ)) {
 			PxAttachObject(&self->pyData, pyData, true);
-			if (!PxComboBox_RenderData(self, true))
+			if (!PxComboBox_RenderData(self, true)) {
+				Py_XDECREF(pyData);
 				Py_RETURN_FALSE;
+			}
 		}
+		Py_XDECREF(pyData);
 		gtk_widget_set_sensitive(self->gtk, !(self->bReadOnly || self->pyDynaset->bLocked));
 	}
 	Py_RETURN_TRUE;
@@ -6,6 +6,19 @@ static bool PxDynaset_UpdateControlWidgets(PxDynasetObject* self);
 static bool PxDynaset_RefreshBoundWidgets(PxDynasetObject* self, bool bNonTable, bool bTable, bool bRowPointer);
 static bool PxDynaset_CleanUp(PxDynasetObject* self);
 static int PxDynaset_Write(PxDynasetObject* self);
+static Py_ssize_t PxDynaset_Fetch(PxDynasetObject* self, Py_ssize_t nMax);
+static bool PxDynaset_CloseCursor(PxDynasetObject* self);
+static bool PxDynaset_RowsAppended(PxDynasetObject* self, Py_ssize_t nFirstRow);
+static void PxDynaset_ForgetStatements(PxDynasetObject* self);
+static bool PxDynaset_ClearFilter(PxDynasetObject* self);
+static bool PxDynaset_FlushChildRefresh(PxDynasetObject* self);
+static bool PxDynaset_WatchStamp(PxDynasetObject* self);
+static PyObject* PxDynaset_RowProxy(PxDynasetObject* self, Py_ssize_t nRow);
+static bool PxDynaset_IsKeyColumn(PxDynasetObject* self, Py_ssize_t nColumn);
+static bool PxDynaset_MoveRow(PxDynasetObject* self, Py_ssize_t nRow, bool bForce);
+static bool PxDynaset_FetchAll(PxDynasetObject* self, const char* sWhat);
+static PyTypeObject PxDynasetRowProxyType;
+static PyTypeObject PxDynasetIterType;
 
 static PyStructSequence_Field PxDynasetColumnFields[] = {
 	{ "name", "Name of column in query" },
@@ -16,6 +29,7 @@ static PyStructSequence_Field PxDynasetColumnFields[] = {
 	{ "get_default", "Function providing default value" },
 	{ "format", "Default display format" },
 	{ "parent", "Coresponding column in parent Dynaset" },
+	{ "expr", "Formula or function computing the data from the other columns of the row, None if not computed" },
 	{ NULL }
 };
 
@@ -23,7 +37,7 @@ static PyStructSequence_Desc PxDynasetColumnDesc = {
 	"DynasetColumn",
 	NULL,
 	PxDynasetColumnFields,
-	8
+	9
 };
 
 static PyStructSequence_Field PxDynasetRowFields[] = {
@@ -50,6 +64,8 @@ PxDynasetTypes_Init()
 	if (PxDynasetRowType.tp_name == 0)
 		PyStructSequence_InitType(&PxDynasetRowType, &PxDynasetRowDesc);
 	Py_INCREF(&PxDynasetRowType);
+	if (PyType_Ready(&PxDynasetRowProxyType) < 0 || PyType_Ready(&PxDynasetIterType) < 0)
+		return false;
 	return true;
 }
 
@@ -64,17 +80,61 @@ PxDynaset_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 		self->bHasWhoCols = true;
 		self->pyQuery = NULL;
 		self->pyCursor = NULL;
-		self->sInsertSQL = NULL;
-		self->sUpdateSQL = NULL;
-		self->sDeleteSQL = NULL;
+		self->bDirect = false;
+		self->pStatement = NULL;
+		self->pStatements[PxSTATEMENT_INSERT] = NULL;
+		self->pStatements[PxSTATEMENT_UPDATE] = NULL;
+		self->pStatements[PxSTATEMENT_DELETE] = NULL;
 		self->pyAutoColumn = NULL;
 		self->pyParams = NULL;
 		self->pyEmptyRowData = NULL;
 		self->pyColumns = NULL;
+		self->pColumnInfo = NULL;
+		self->nColumnInfo = 0;
+		self->nDataColumns = 0;
+		self->nComputed = 0;
 		self->pyRows = NULL;
+		self->pStore = NULL;
+		self->bColumnar = false;
 		self->nRows = 0;
 		self->nRow = -1;
-		self->nRowEnd = -1;
+		self->pnSelected = NULL;
+		self->nSelected = 0;
+		self->nFetchSize = 0;
+		self->bFetchComplete = true;
+		self->iFetchSourceID = 0;
+		self->bPaged = false;
+		self->nPagesKept = 8;
+		self->bPageStart = true;
+		self->nRowOffset = 0;
+		self->nRowGeneration = 0;
+		self->nRowsTotal = -1;
+		self->pyParameters = NULL;
+		self->iPageSourceID = 0;
+		self->iChildRefreshDelay = 0;
+		self->iChildRefreshSourceID = 0;
+		self->pnVisible = NULL;
+		self->nVisible = 0;
+		self->pnDirty = NULL;
+		self->nDirty = 0;
+		self->nDirtyCapacity = 0;
+		self->pJournal = NULL;
+		self->nJournal = 0;
+		self->nJournalPosition = 0;
+		self->nJournalCapacity = 0;
+		self->pyKeyIndex = NULL;
+		self->pQuery = NULL;
+		self->bLoading = false;
+		self->nCacheSize = 0;
+		self->pyCache = NULL;
+		self->pyCacheKey = NULL;
+		self->iCacheChanges = -1;
+		self->iCacheVersion = -1;
+		self->iWatchInterval = 0;
+		self->iWatchSourceID = 0;
+		self->iWatchVersion = -1;
+		self->bStale = false;
+		self->bAutoRefresh = false;
 		self->iLastRowID = -1;
 		self->bAutoExecute = true;
 		self->bReadOnly = false;
@@ -103,15 +163,19 @@ PxDynaset_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 static int
 PxDynaset_init(PxDynasetObject* self, PyObject* args, PyObject* kwds)
 {
-	static char *kwlist[] = { "table", "query", "parent", "cnx", NULL };
+	static char *kwlist[] = { "table", "query", "parent", "cnx", "columnar", "direct", NULL };
 	PyObject* pyTable = NULL, *pyQuery = NULL, *pyParent = NULL, *pyConnection = NULL, *tmp;
+	int bColumnar = false, bDirect = false;
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO", kwlist,
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOpp", kwlist,
 		&pyTable,
 		&pyQuery,
 		&pyParent,
-		&pyConnection))
+		&pyConnection,
+		&bColumnar,
+		&bDirect))
 		return -1;
+	self->bColumnar = bColumnar;
 
 	if (PyUnicode_Check(pyTable))
 		PxAttachObject(&self->pyTable, pyTable, true);
@@ -158,6 +222,11 @@ PxDynaset_init(PxDynasetObject* self, PyObject* args, PyObject* kwds)
 		self->pyConnection = g.pyConnection;
 	}
 
+	// opt in only, columns are decoded as on a connection opened with detect_types=PARSE_DECLTYPES | PARSE_COLNAMES
+	self->bDirect = bDirect;
+	if (self->bDirect && PxQuery_Handle(self->pyConnection) == NULL)
+		return -1;
+
 	if ((self->pyRows = PyList_New(0)) == NULL) {
 		PyErr_SetString(PyExc_RuntimeError, "Can not create list of rows.");
 		return -1;
@@ -178,20 +247,388 @@ PxDynaset_init(PxDynasetObject* self, PyObject* args, PyObject* kwds)
 	return 0;
 }
 
+static PxDynasetColumnInfo*
+PxDynaset_FindColumn(PxDynasetObject* self, PyObject* pyColumn)
+// descriptor of a DynasetColumn, NULL if it does not belong to this Dynaset
+{
+	Py_ssize_t n;
+	for (n = 0; n < self->nColumnInfo; n++)
+		if (self->pColumnInfo[n].pyColumn == pyColumn)
+			return self->pColumnInfo + n;
+	return NULL;
+}
+
+static void
+PxDynaset_SetColumnIndex(PxDynasetColumnInfo* pInfo, Py_ssize_t nIndex)
+// keep the DynasetColumn's index in line with the descriptor
+{
+	PyObject* pyIndex;
+
+	pInfo->nIndex = nIndex;
+	if (nIndex == -1) {
+		pyIndex = Py_None;
+		Py_INCREF(Py_None);
+	}
+	else
+		pyIndex = PyLong_FromSsize_t(nIndex);
+	Py_DECREF(PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_INDEX));
+	PyStructSequence_SET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_INDEX, pyIndex);
+}
+
+// Computed columns
+// A formula like "Quantity * Price" is compiled once into postfix steps over the other columns of the row and evaluated without running Python code.
+// Operands are column names, "quoted names", numbers and 'strings', operators + - * / and || (concatenation); coalesce() gives its first operand that is not None.
+
+typedef struct _PxExprParser
+{
+	PxDynasetObject* pyDynaset;
+	const char* sText;
+	const char* s;            // current position
+	Py_ssize_t nPosition;     // of the computed column in pColumnInfo
+	PxExprStep* pSteps;
+	Py_ssize_t nSteps;
+	Py_ssize_t nCapacity;
+}
+PxExprParser;
+
+static void
+PxDynaset_FreeSteps(PxExprStep* pSteps, Py_ssize_t nSteps)
+{
+	Py_ssize_t n;
+	for (n = 0; n < nSteps; n++)
+		Py_XDECREF(pSteps[n].pyValue);
+	PyMem_RawFree(pSteps);
+}
+
+static bool
+PxExprParser_Emit(PxExprParser* pParser, int iOperation, Py_ssize_t nArgument, PyObject* pyValue)
+// append a step, pyValue is stolen
+{
+	PxExprStep* pSteps;
+	Py_ssize_t nCapacity;
+
+	if (pParser->nSteps == pParser->nCapacity) {
+		nCapacity = pParser->nCapacity ? pParser->nCapacity * 2 : 16;
+		if ((pSteps = (PxExprStep*)PyMem_RawRealloc(pParser->pSteps, nCapacity * sizeof(PxExprStep))) == NULL) {
+			Py_XDECREF(pyValue);
+			PyErr_NoMemory();
+			return false;
+		}
+		pParser->pSteps = pSteps;
+		pParser->nCapacity = nCapacity;
+	}
+	pParser->pSteps[pParser->nSteps].iOperation = iOperation;
+	pParser->pSteps[pParser->nSteps].nArgument = nArgument;
+	pParser->pSteps[pParser->nSteps++].pyValue = pyValue;
+	return true;
+}
+
+static bool
+PxExprParser_Fail(PxExprParser* pParser, const char* sMessage)
+{
+	PyErr_Format(PyExc_ValueError, "%s at position %d of formula '%s'.", sMessage, (int)(pParser->s - pParser->sText) + 1, pParser->sText);
+	return false;
+}
+
+static bool
+PxExprParser_Accept(PxExprParser* pParser, const char* sToken)
+// skip white space, then the token if it comes next
+{
+	size_t nLength = strlen(sToken);
+
+	while (g_ascii_isspace(*pParser->s))
+		pParser->s++;
+	if (strncmp(pParser->s, sToken, nLength) != 0)
+		return false;
+	pParser->s += nLength;
+	return true;
+}
+
+static PyObject* // new ref
+PxExprParser_Quoted(PxExprParser* pParser, char cQuote)
+// text up to the closing quote, which is doubled to be part of it
+{
+	const char* sStart = ++pParser->s;
+	PyObject* pyText, *pyQuote, *pyDoubled;
+	bool bDoubled = false;
+
+	for (;;) {
+		if (*pParser->s == '\0') {
+			PxExprParser_Fail(pParser, "Closing quote missing");
+			return NULL;
+		}
+		if (*pParser->s == cQuote) {
+			if (pParser->s[1] != cQuote)
+				break;
+			bDoubled = true;
+			pParser->s++;
+		}
+		pParser->s++;
+	}
+	pyText = PyUnicode_DecodeUTF8(sStart, pParser->s++ - sStart, NULL);
+	if (pyText == NULL || !bDoubled)
+		return pyText;
+	pyQuote = PyUnicode_FromStringAndSize(&cQuote, 1);
+	pyDoubled = pyQuote ? PyUnicode_Concat(pyQuote, pyQuote) : NULL;
+	Py_SETREF(pyText, pyDoubled ? PyUnicode_Replace(pyText, pyDoubled, pyQuote, -1) : NULL);
+	Py_XDECREF(pyQuote);
+	Py_XDECREF(pyDoubled);
+	return pyText;
+}
+
+static bool
+PxExprParser_Column(PxExprParser* pParser, PyObject* pyName)
+// reference to a column added before, or to a database column, pyName is borrowed
+{
+	PxDynasetObject* self = pParser->pyDynaset;
+	PyObject* pyColumn;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t nPosition;
+
+	if ((pyColumn = PyDict_GetItem(self->pyColumns, pyName)) == NULL || (pInfo = PxDynaset_FindColumn(self, pyColumn)) == NULL) {
+		PyErr_Format(PyExc_ValueError, "Formula '%s' refers to unknown column '%s'.", pParser->sText, PyUnicode_AsUTF8(pyName));
+		return false;
+	}
+	nPosition = pInfo - self->pColumnInfo;
+	if (nPosition == pParser->nPosition) {
+		PyErr_Format(PyExc_ValueError, "Formula '%s' refers to the column it computes.", pParser->sText);
+		return false;
+	}
+	if (pInfo->pyExpr && nPosition > pParser->nPosition) { // columns are computed in the order they have been added
+		PyErr_Format(PyExc_ValueError, "Formula '%s' refers to computed column '%s', which has been added after it.", pParser->sText, PyUnicode_AsUTF8(pyName));
+		return false;
+	}
+	return PxExprParser_Emit(pParser, PxEXPR_COLUMN, nPosition, NULL);
+}
+
+static bool PxExprParser_Sum(PxExprParser* pParser);
+
+static bool
+PxExprParser_Operand(PxExprParser* pParser)
+// number, string, column, coalesce(...) or formula in parentheses, optionally negated
+{
+	const char* sStart;
+	size_t nLength;
+	PyObject* pyText, *pyValue;
+	Py_ssize_t nOperands = 0;
+	bool bReal = false, bOk;
+
+	if (PxExprParser_Accept(pParser, "-"))
+		return PxExprParser_Operand(pParser) && PxExprParser_Emit(pParser, PxEXPR_NEGATE, 0, NULL);
+	if (PxExprParser_Accept(pParser, "("))
+		return PxExprParser_Sum(pParser) && (PxExprParser_Accept(pParser, ")") || PxExprParser_Fail(pParser, "')' expected"));
+
+	sStart = pParser->s;
+	if (g_ascii_isdigit(*sStart) || (*sStart == '.' && g_ascii_isdigit(sStart[1]))) {
+		for (; g_ascii_isdigit(*pParser->s) || (*pParser->s == '.' && !bReal); pParser->s++)
+			bReal |= *pParser->s == '.';
+		if (*pParser->s == '.')
+			return PxExprParser_Fail(pParser, "Second decimal point in number");
+		if ((pyText = PyUnicode_FromStringAndSize(sStart, pParser->s - sStart)) == NULL)
+			return false;
+		pyValue = bReal ? PyFloat_FromString(pyText) : PyLong_FromUnicodeObject(pyText, 10);
+		Py_DECREF(pyText);
+		return pyValue && PxExprParser_Emit(pParser, PxEXPR_CONSTANT, 0, pyValue);
+	}
+	if (*sStart == '\'')
+		return (pyValue = PxExprParser_Quoted(pParser, '\'')) != NULL && PxExprParser_Emit(pParser, PxEXPR_CONSTANT, 0, pyValue);
+	if (*sStart == '"') {
+		if ((pyText = PxExprParser_Quoted(pParser, '"')) == NULL)
+			return false;
+		bOk = PxExprParser_Column(pParser, pyText);
+		Py_DECREF(pyText);
+		return bOk;
+	}
+	if (!(g_ascii_isalpha(*sStart) || *sStart == '_' || (unsigned char)*sStart >= 0x80))
+		return PxExprParser_Fail(pParser, "Operand expected");
+
+	while (g_ascii_isalnum(*pParser->s) || *pParser->s == '_' || (unsigned char)*pParser->s >= 0x80)
+		pParser->s++;
+	nLength = pParser->s - sStart;
+	if (!PxExprParser_Accept(pParser, "(")) {
+		if ((pyText = PyUnicode_DecodeUTF8(sStart, nLength, NULL)) == NULL)
+			return false;
+		bOk = PxExprParser_Column(pParser, pyText);
+		Py_DECREF(pyText);
+		return bOk;
+	}
+	if (!((nLength == 8 && g_ascii_strncasecmp(sStart, "coalesce", 8) == 0) || (nLength == 6 && g_ascii_strncasecmp(sStart, "ifnull", 6) == 0))) {
+		pParser->s = sStart;
+		return PxExprParser_Fail(pParser, "Unknown function");
+	}
+	do {
+		if (!PxExprParser_Sum(pParser))
+			return false;
+		nOperands++;
+	} while (PxExprParser_Accept(pParser, ","));
+	if (!PxExprParser_Accept(pParser, ")"))
+		return PxExprParser_Fail(pParser, "')' expected");
+	return PxExprParser_Emit(pParser, PxEXPR_COALESCE, nOperands, NULL);
+}
+
+static bool
+PxExprParser_Concatenation(PxExprParser* pParser)
+// || binds tighter than arithmetic, as in SQL
+{
+	if (!PxExprParser_Operand(pParser))
+		return false;
+	while (PxExprParser_Accept(pParser, "||"))
+		if (!PxExprParser_Operand(pParser) || !PxExprParser_Emit(pParser, PxEXPR_CONCAT, 0, NULL))
+			return false;
+	return true;
+}
+
+static bool
+PxExprParser_Product(PxExprParser* pParser)
+{
+	int iOperation;
+
+	if (!PxExprParser_Concatenation(pParser))
+		return false;
+	for (;;) {
+		if (PxExprParser_Accept(pParser, "*"))
+			iOperation = PxEXPR_MULTIPLY;
+		else if (PxExprParser_Accept(pParser, "/"))
+			iOperation = PxEXPR_DIVIDE;
+		else
+			return true;
+		if (!PxExprParser_Concatenation(pParser) || !PxExprParser_Emit(pParser, iOperation, 0, NULL))
+			return false;
+	}
+}
+
+static bool
+PxExprParser_Sum(PxExprParser* pParser)
+{
+	int iOperation;
+
+	if (!PxExprParser_Product(pParser))
+		return false;
+	for (;;) {
+		if (PxExprParser_Accept(pParser, "+"))
+			iOperation = PxEXPR_ADD;
+		else if (PxExprParser_Accept(pParser, "-"))
+			iOperation = PxEXPR_SUBTRACT;
+		else
+			return true;
+		if (!PxExprParser_Product(pParser) || !PxExprParser_Emit(pParser, iOperation, 0, NULL))
+			return false;
+	}
+}
+
+static bool
+PxDynaset_CompileExpr(PxDynasetObject* self, PyObject* pyExpr, Py_ssize_t nPosition, PxExprStep** ppSteps, Py_ssize_t* pnSteps)
+// formula of the column at nPosition in pColumnInfo into postfix steps
+{
+	PxExprParser parser = { self, NULL, NULL, nPosition, NULL, 0, 0 };
+
+	if ((parser.sText = PyUnicode_AsUTF8(pyExpr)) == NULL)
+		return false;
+	parser.s = parser.sText;
+	if (PxExprParser_Sum(&parser)) {
+		PxExprParser_Accept(&parser, ""); // trailing white space
+		if (*parser.s == '\0') {
+			*ppSteps = parser.pSteps;
+			*pnSteps = parser.nSteps;
+			return true;
+		}
+		PxExprParser_Fail(&parser, "Unexpected character");
+	}
+	PxDynaset_FreeSteps(parser.pSteps, parser.nSteps);
+	return false;
+}
+
+static bool
+PxDynaset_DependsOn(PxDynasetObject* self, PxDynasetColumnInfo* pInfo, PxDynasetColumnInfo* pChanged)
+// whether the computed column is to be recomputed when the other one changes
+{
+	Py_ssize_t n, nPosition = pChanged - self->pColumnInfo;
+
+	if (pInfo->pSteps == NULL) // a callable may read any column that is not computed itself
+		return pChanged->pyExpr == NULL;
+	for (n = 0; n < pInfo->nSteps; n++)
+		if (pInfo->pSteps[n].iOperation == PxEXPR_COLUMN && pInfo->pSteps[n].nArgument == nPosition)
+			return true;
+	return false;
+}
+
+static bool
+PxDynaset_DescribeColumn(PxDynasetObject* self, PyObject* pyColumn)
+// enter a new DynasetColumn into the descriptor table, replacing one of the same name
+{
+	PyObject* pyKey, *pyParentColumn, *pyOldColumn, *pyExpr;
+	PxDynasetColumnInfo* pInfo = NULL, *pInfos;
+	PxExprStep* pSteps = NULL;
+	Py_ssize_t nSteps = 0, nPosition, n;
+
+	if ((pyOldColumn = PyDict_GetItem(self->pyColumns, PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_NAME))) != NULL)
+		pInfo = PxDynaset_FindColumn(self, pyOldColumn);
+	nPosition = pInfo ? pInfo - self->pColumnInfo : self->nColumnInfo;
+
+	pyExpr = PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_EXPR);
+	if (PyUnicode_Check(pyExpr) && !PxDynaset_CompileExpr(self, pyExpr, nPosition, &pSteps, &nSteps))
+		return false;
+	if (pyExpr != Py_None && pInfo && pInfo->pyExpr == NULL) {
+		for (n = 0; n < nPosition; n++)
+			if (self->pColumnInfo[n].pSteps && PxDynaset_DependsOn(self, self->pColumnInfo + n, pInfo)) {
+				PyErr_Format(PyExc_ValueError, "Column '%s' is used by computed column '%s', which has been added before it.",
+					PyUnicode_AsUTF8(PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_NAME)), PyUnicode_AsUTF8(PyStructSequence_GET_ITEM(self->pColumnInfo[n].pyColumn, PXDYNASETCOLUMN_NAME)));
+				PxDynaset_FreeSteps(pSteps, nSteps);
+				return false;
+			}
+	}
+
+	if (pInfo == NULL) {
+		if ((pInfos = (PxDynasetColumnInfo*)PyMem_RawRealloc(self->pColumnInfo, (self->nColumnInfo + 1) * sizeof(PxDynasetColumnInfo))) == NULL) {
+			PxDynaset_FreeSteps(pSteps, nSteps);
+			PyErr_NoMemory();
+			return false;
+		}
+		self->pColumnInfo = pInfos;
+		pInfo = self->pColumnInfo + self->nColumnInfo++;
+		pInfo->nIndex = -1;
+		pInfo->pyExpr = NULL;
+		pInfo->pSteps = NULL;
+		pInfo->nSteps = 0;
+		if (self->nRows == 0 && self->pStore == NULL) // rows get the new column only once the query is run again
+			pInfo->nIndex = self->nDataColumns++;
+	}
+
+	pInfo->pyColumn = pyColumn;
+	pInfo->iKind = PxColumnStore_KindForType(PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_TYPE));
+	pyKey = PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_KEY);
+	pInfo->iKey = (pyKey == Py_True) ? 1 : (pyKey == Py_False ? 0 : -1);
+	pyParentColumn = PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_PARENT);
+	pInfo->pyParentColumn = (pyParentColumn == Py_None) ? NULL : pyParentColumn;
+	if (pInfo->pyExpr)
+		self->nComputed--;
+	PxDynaset_FreeSteps(pInfo->pSteps, pInfo->nSteps);
+	pInfo->pyExpr = (pyExpr == Py_None) ? NULL : pyExpr;
+	pInfo->pSteps = pSteps;
+	pInfo->nSteps = nSteps;
+	if (pInfo->pyExpr)
+		self->nComputed++;
+	PxDynaset_SetColumnIndex(pInfo, pInfo->nIndex);
+	Py_CLEAR(self->pyEmptyRowData);
+	Py_CLEAR(self->pyKeyIndex);
+	return true;
+}
+
 static PyObject* // new ref
 PxDynaset_add_column(PxDynasetObject* self, PyObject *args, PyObject *kwds)
 {
-	static char *kwlist[] = { "name", "type", "key", "format", "default", "defaultFunction", "parent", NULL };
-	PyObject* pyName = NULL, *pyType = NULL, *pyKey = NULL, *pyFormat = NULL, *pyDefault = NULL, *pyDefaultFunction = NULL, *pyParent = NULL, *pyParentColumn = NULL;
+	static char *kwlist[] = { "name", "type", "key", "format", "default", "defaultFunction", "parent", "expr", NULL };
+	PyObject* pyName = NULL, *pyType = NULL, *pyKey = NULL, *pyFormat = NULL, *pyDefault = NULL, *pyDefaultFunction = NULL, *pyParent = NULL, *pyParentColumn = NULL, *pyExpr = NULL;
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOOOO", kwlist,
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOOOOO", kwlist,
 		&pyName,
 		&pyType,
 		&pyKey,
 		&pyFormat,
 		&pyDefault,
 		&pyDefaultFunction,
-		&pyParent))
+		&pyParent,
+		&pyExpr))
 		return NULL;
 
 	if (!PyUnicode_Check(pyName)) {
@@ -209,6 +646,20 @@ PxDynaset_add_column(PxDynasetObject* self, PyObject *args, PyObject *kwds)
 		pyType = (PyObject*)&PyUnicode_Type;
 	}
 
+	if (pyExpr && pyExpr != Py_None) {
+		if (!PyUnicode_Check(pyExpr) && !PyCallable_Check(pyExpr)) {
+			PyErr_SetString(PyExc_TypeError, "Parameter 8 ('expr') must be a string or a callable object.");
+			return NULL;
+		}
+		if (pyKey && pyKey != Py_None) {
+			PyErr_SetString(PyExc_ValueError, "A computed column cannot be a database column, 'key' must be None.");
+			return NULL;
+		}
+		pyKey = Py_None;
+	}
+	else
+		pyExpr = Py_None;
+
 	if (pyKey) {
 		if (pyKey != Py_True && pyKey != Py_False && pyKey != Py_None) {
 			PyErr_SetString(PyExc_TypeError, "Parameter 3 ('key') must be a boolean or None.");
@@ -264,6 +715,7 @@ PxDynaset_add_column(PxDynasetObject* self, PyObject *args, PyObject *kwds)
 	Py_INCREF(pyDefault);
 	Py_INCREF(pyDefaultFunction);
 	Py_INCREF(pyParentColumn);
+	Py_INCREF(pyExpr);
 
 	PyObject* pyColumn = PyStructSequence_New(&PxDynasetColumnType);
 	PyStructSequence_SET_ITEM(pyColumn, PXDYNASETCOLUMN_NAME, pyName);
@@ -274,11 +726,15 @@ PxDynaset_add_column(PxDynasetObject* self, PyObject *args, PyObject *kwds)
 	PyStructSequence_SET_ITEM(pyColumn, PXDYNASETCOLUMN_DEFAULT, pyDefault);
 	PyStructSequence_SET_ITEM(pyColumn, PXDYNASETCOLUMN_DEFFUNC, pyDefaultFunction);
 	PyStructSequence_SET_ITEM(pyColumn, PXDYNASETCOLUMN_PARENT, pyParentColumn);
+	PyStructSequence_SET_ITEM(pyColumn, PXDYNASETCOLUMN_EXPR, pyExpr);
 
 	//Py_INCREF(pyName);
+	if (!PxDynaset_DescribeColumn(self, pyColumn))
+		return NULL;
 	if (PyDict_SetItem(self->pyColumns, pyName, pyColumn) == -1) {
 		return NULL;
 	}
+	PxDynaset_ForgetStatements(self);
 	return(pyColumn);
 }
 
@@ -294,884 +750,5213 @@ PxDynaset_get_column(PxDynasetObject* self, PyObject *args)
 	return pyColumn;
 }
 
-PyObject* // borrowed ref
-PxDynaset_GetData(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn)
+// Row storage
+// Rows are kept either as DynasetRow structures in pyRows or, if the Dynaset is columnar, in pStore.
+// Everything below accesses row data and row state through these functions only.
+
+static Py_ssize_t
+PxDynaset_ColumnIndex(PyObject* pyColumn)
+// position of the column in the row data, -1 with exception if it is not part of the query
 {
-	if (nRow == -1)
-		nRow = self->nRow;
-	if (nRow < 0 || nRow > self->nRows) {
-		PyErr_SetString(PyExc_IndexError, "Cannot get data from Dynaset. Row number out of range.");
-		return NULL;
+	PyObject* pyIndex = PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_INDEX);
+	if (pyIndex == Py_None) {
+		PyErr_Format(PyExc_AttributeError, "Column '%s' is not part of the query.", PyUnicode_AsUTF8(PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_NAME)));
+		return -1;
 	}
-
-	Py_ssize_t nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-	PyObject* pyRow = PyList_GetItem(self->pyRows, nRow);
-	PyObject* pyRowData = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATA);
-	PyObject* pyDataItem = PyTuple_GetItem(pyRowData, nColumn);
-	return pyDataItem;
+	return PyLong_AsSsize_t(pyIndex);
 }
 
-static PyObject* // new ref
-PxDynaset_get_data(PxDynasetObject* self, PyObject *args)
+// Dirty rows
+// Rows are listed in pnDirty when they become new, deleted or modified. Entries are dropped lazily, so a listed row may be clean again.
+
+static Py_ssize_t
+PxDynaset_DirtyPosition(PxDynasetObject* self, Py_ssize_t nRow)
+// index of the first entry not below nRow
 {
-	Py_ssize_t nRow = self->nRow;
-	PyObject* pyColumn, *pyData;
-	if (!PyArg_ParseTuple(args, "O|n", &pyColumn, &nRow)) {
-		return NULL;
-	}
-	if (nRow < -1 || nRow > self->nRows) {
-		PyErr_SetString(PyExc_IndexError, "Cannot get data from Dynaset. Row number out of range.");
-		return NULL;
-	}
+	Py_ssize_t nLow = 0, nHigh = self->nDirty, nMiddle;
 
-	if (PyUnicode_Check(pyColumn)) {
-		pyData = pyColumn;
-		pyColumn = PyDict_GetItem(self->pyColumns, pyData);
-		if (!pyColumn)
-			return PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyData));
+	while (nLow < nHigh) {
+		nMiddle = (nLow + nHigh) / 2;
+		if (self->pnDirty[nMiddle] < nRow)
+			nLow = nMiddle + 1;
+		else
+			nHigh = nMiddle;
 	}
-	pyData = PxDynaset_GetData(self, nRow, pyColumn);
-
-	if (pyData == NULL)
-		return NULL;
-	Py_INCREF(pyData);
-	return pyData;
+	return nLow;
 }
 
-bool
-PxDynaset_SetData(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn, PyObject* pyData)
+static bool
+PxDynaset_MarkDirty(PxDynasetObject* self, Py_ssize_t nRow)
 {
-	Py_ssize_t nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-	PyObject* pyRow = PyList_GetItem(self->pyRows, nRow);
-	PyObject* pyRowData = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATA);
-	PyObject* pyRowDataOld = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATAOLD);
-	PyObject* pyRowNew = PyStructSequence_GetItem(pyRow, PXDYNASETROW_NEW);
-	PyObject* pyDataOld = NULL;
-	//g_debug("*---- PxDynaset_SetData");
+	Py_ssize_t* pnDirty, nPosition = PxDynaset_DirtyPosition(self, nRow), nCapacity;
 
-	if (pyRowDataOld == Py_None && pyRowNew == Py_False) { // keep a copy of the original data tuple
-		Py_ssize_t nSize = PyTuple_Size(pyRowData);
-		pyRowDataOld = PyTuple_Duplicate(pyRowData);
-		Py_DECREF(Py_None);
-		PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DATAOLD, pyRowDataOld);
+	if (nPosition < self->nDirty && self->pnDirty[nPosition] == nRow)
+		return true;
+	if (self->nDirty == self->nDirtyCapacity) {
+		nCapacity = self->nDirtyCapacity ? self->nDirtyCapacity * 2 : 16;
+		if ((pnDirty = (Py_ssize_t*)PyMem_RawRealloc(self->pnDirty, nCapacity * sizeof(Py_ssize_t))) == NULL) {
+			PyErr_NoMemory();
+			return false;
+		}
+		self->pnDirty = pnDirty;
+		self->nDirtyCapacity = nCapacity;
 	}
-	pyDataOld = PyTuple_GetItem(pyRowData, nColumn);
-	PyTuple_SET_ITEM(pyRowData, nColumn, pyData);
-	Py_XDECREF(pyDataOld);
-	PxDynaset_Stain(self);
-
-	return PxDynaset_DataChanged(self, nRow, pyColumn);
+	memmove(self->pnDirty + nPosition + 1, self->pnDirty + nPosition, (self->nDirty - nPosition) * sizeof(Py_ssize_t));
+	self->pnDirty[nPosition] = nRow;
+	self->nDirty++;
+	return true;
 }
 
-static PyObject* // new ref
-PxDynaset_set_data(PxDynasetObject* self, PyObject *args)
+static void
+PxDynaset_DropDirty(PxDynasetObject* self)
 {
-	Py_ssize_t nRow = self->nRow;
-	PyObject* pyColumn, *pyColumnName, *pyData;
-	if (!PyArg_ParseTuple(args, "OO|n", &pyColumn, &pyData, &nRow)) {
-		return NULL;
-	}
-	if (nRow < -1 || nRow > self->nRows) {
-		PyErr_SetString(PyExc_IndexError, "Cannot set data in Dynaset. Row number out of range.");
-		//g_debug("PxDynaset_set_data nRow %d", nRow);
-		return NULL;
-	}
+	PyMem_RawFree(self->pnDirty);
+	self->pnDirty = NULL;
+	self->nDirty = self->nDirtyCapacity = 0;
+}
 
-	if (PyUnicode_Check(pyColumn)) {
-		pyColumnName = pyColumn;
-		pyColumn = PyDict_GetItem(self->pyColumns, pyColumnName);
-		if (!pyColumn)
-			return PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyColumnName));
-	}
-	else if (!PyObject_TypeCheck(pyColumn, &PxDynasetColumnType)) {
-		PyErr_SetString(PyExc_TypeError, "'column' must be a DataColumn.");
-		return NULL;
-	}
+static bool
+PxDynaset_HasDirtyRows(PxDynasetObject* self)
+// prunes rows that have become clean again
+{
+	Py_ssize_t n, nTo = 0;
 
-	if (!PxDynaset_SetData(self, nRow, pyColumn, pyData))
-		return NULL;
-	Py_RETURN_NONE;
+	for (n = 0; n < self->nDirty; n++)
+		if (PxDynaset_GetRowState(self, self->pnDirty[n]) != 0)
+			self->pnDirty[nTo++] = self->pnDirty[n];
+	self->nDirty = nTo;
+	return nTo > 0;
 }
 
-static PyObject* // new ref
-PxDynaset_get_row(PxDynasetObject* self, PyObject* args)
+static Py_ssize_t
+PxDynaset_SqueezeRowList(Py_ssize_t* pnList, Py_ssize_t nList, const Py_ssize_t* pnRows, Py_ssize_t nCount)
+// take the removed rows pnRows out of the ascending list pnList and renumber the others, returns the new length
 {
-	Py_ssize_t nRow = self->nRow;
-	PyObject* pyRow = NULL;
+	Py_ssize_t n, nTo = 0, nGone = 0;
 
-	if (!PyArg_ParseTuple(args, "|n", &nRow)) {
-		return NULL;
-	}
-	if (nRow < 0)
-		Py_RETURN_NONE;
-	else if (nRow > self->nRows) {
-		PyErr_SetString(PyExc_IndexError, "Cannot get row from Dynaset. Row number out of range.");
-		//g_debug("PxDynaset_get_row nRow %d", nRow);
-		return NULL;
-	}
-	pyRow = PyList_GetItem(self->pyRows, nRow);
-	if (pyRow) {
-		Py_INCREF(pyRow);
-		return pyRow;
+	for (n = 0; n < nList; n++) {
+		while (nGone < nCount && pnRows[nGone] < pnList[n])
+			nGone++;
+		if (nGone < nCount && pnRows[nGone] == pnList[n])
+			continue;
+		pnList[nTo++] = pnList[n] - nGone;
 	}
-	else
-		return NULL;
+	return nTo;
 }
 
-static PyObject* // new ref
-PxDynaset_get_row_data(PxDynasetObject* self, PyObject* args)
+static bool
+PxDynaset_PermuteRowList(Py_ssize_t* pnList, Py_ssize_t nList, const Py_ssize_t* pnOrder, Py_ssize_t nRows)
+// renumber the rows of the ascending list after row n has become the former row pnOrder[n]
 {
-	Py_ssize_t nRow = self->nRow;
-	PyObject* pyRow = NULL;
+	unsigned char* pListed;
+	Py_ssize_t n, nTo = 0;
 
-	if (!PyArg_ParseTuple(args, "|n", &nRow)) {
-		return NULL;
+	if ((pListed = (unsigned char*)PyMem_RawCalloc(nRows ? nRows : 1, 1)) == NULL) {
+		PyErr_NoMemory();
+		return false;
 	}
-	if (nRow < 0)
-		Py_RETURN_NONE;
-	else if (nRow > self->nRows) {
-		PyErr_SetString(PyExc_IndexError, "Cannot get row data from Dynaset. Row number out of range.");
-		return NULL;
+	for (n = 0; n < nList; n++)
+		pListed[pnList[n]] = 1;
+	for (n = 0; n < nRows; n++)
+		if (pListed[pnOrder[n]])
+			pnList[nTo++] = n;
+	PyMem_RawFree(pListed);
+	return true;
+}
+
+unsigned char
+PxDynaset_GetRowState(PxDynasetObject* self, Py_ssize_t nRow)
+{
+	PyObject* pyRow;
+	unsigned char cState = 0;
+
+	if (self->pStore)
+		return self->pStore->pState[nRow];
+
+	pyRow = PyList_GET_ITEM(self->pyRows, nRow);
+	if (PyStructSequence_GET_ITEM(pyRow, PXDYNASETROW_NEW) == Py_True)
+		cState |= PxROW_NEW;
+	if (PyStructSequence_GET_ITEM(pyRow, PXDYNASETROW_DELETE) == Py_True)
+		cState |= PxROW_DELETE;
+	if (PyStructSequence_GET_ITEM(pyRow, PXDYNASETROW_DATAOLD) != Py_None)
+		cState |= PxROW_MODIFIED;
+	return cState;
+}
+
+static bool
+PxDynaset_SetRowFlag(PxDynasetObject* self, Py_ssize_t nRow, unsigned char cFlag, bool bSet)
+// set or reset PxROW_NEW or PxROW_DELETE
+{
+	PyObject* pyRow, *pyFlag, *pyFlagOld;
+	Py_ssize_t nItem;
+
+	if (bSet && !PxDynaset_MarkDirty(self, nRow))
+		return false;
+
+	if (self->pStore) {
+		if (bSet)
+			self->pStore->pState[nRow] |= cFlag;
+		else
+			self->pStore->pState[nRow] &= ~cFlag;
+		return true;
 	}
-	return PxDynaset_GetRowDataDict(self, nRow, false);
+
+	nItem = (cFlag == PxROW_NEW) ? PXDYNASETROW_NEW : PXDYNASETROW_DELETE;
+	pyRow = PyList_GET_ITEM(self->pyRows, nRow);
+	pyFlagOld = PyStructSequence_GET_ITEM(pyRow, nItem);
+	pyFlag = bSet ? Py_True : Py_False;
+	Py_INCREF(pyFlag);
+	PyStructSequence_SET_ITEM(pyRow, nItem, pyFlag);
+	Py_XDECREF(pyFlagOld);
+	return true;
 }
 
 static PyObject* // new ref
-PxDynaset_get_column_data_sum(PxDynasetObject* self, PyObject *args)
+PxDynaset_GetCell(PxDynasetObject* self, Py_ssize_t nRow, Py_ssize_t nColumn)
 {
-	PyObject* pyColumn, *pyColumnName, *pyData, *pyType;
-	if (!PyArg_ParseTuple(args, "O", &pyColumn)) {
-		return NULL;
-	}
+	PyObject* pyRowData, *pyData;
 
-	if (PyUnicode_Check(pyColumn)) {
-		pyColumnName = pyColumn;
-		pyColumn = PyDict_GetItem(self->pyColumns, pyColumnName);
-		if (!pyColumn)
-			return PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyColumnName));
-	}
-	else if (!PyObject_TypeCheck(pyColumn, &PxDynasetColumnType)) {
-		PyErr_SetString(PyExc_TypeError, "'column' must be a DataColumn.");
-		return NULL;
-	}
+	if (self->pStore)
+		return PxColumnStore_GetItem(self->pStore, nRow, nColumn);
 
-	Py_ssize_t nRow, nLen, nColumn;
-	PyObject* pyRow, *pyRowData, *pyDataItem;
-	long iSum = 0;
-	double fSum = 0;
-
-	nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-	pyType = PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_TYPE);
-	nLen = PySequence_Size(self->pyRows);
-	for (nRow = 0; nRow < nLen; nRow++) {
-		pyRow = PyList_GetItem(self->pyRows, nRow);
-		pyRowData = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATA);
-		pyDataItem = PyTuple_GetItem(pyRowData, nColumn);
-		if(PyLong_Check(pyDataItem))
-		    iSum += PyLong_AsLong(pyDataItem);
-		else if(PyLong_Check(pyDataItem))
-		    fSum += PyFloat_AsDouble(pyDataItem);
-	}
-
-	if (pyType == &PyLong_Type)
-	    return PyLong_FromLong(iSum);
-	else if (pyType == &PyFloat_Type)
-	    return PyFloat_FromDouble(fSum);
-    Py_RETURN_NONE;
+	pyRowData = PyStructSequence_GET_ITEM(PyList_GET_ITEM(self->pyRows, nRow), PXDYNASETROW_DATA);
+	pyData = PyTuple_GetItem(pyRowData, nColumn);
+	Py_XINCREF(pyData);
+	return pyData;
 }
 
-bool
-PxDynaset_Clear(PxDynasetObject* self)
+static bool
+PxDynaset_PutCell(PxDynasetObject* self, Py_ssize_t nRow, Py_ssize_t nColumn, PyObject* pyData)
+// store data without touching the row state
 {
-	if (self->nRows == 0)
-		return true;
-
-	else if (!PxDynaset_SetRow(self, -1))
-		return false;
+	PyObject* pyRowData, *pyDataOld;
 
-	Py_DECREF(self->pyRows);
-	self->pyRows = PyList_New(0);
-	self->nRows = 0;
-	self->nRow = -1;
-	Py_XDECREF(self->pyEmptyRowData);
-	self->pyEmptyRowData = NULL;
+	if (self->pyKeyIndex && PxDynaset_IsKeyColumn(self, nColumn))
+		Py_CLEAR(self->pyKeyIndex);
+	if (self->pStore)
+		return PxColumnStore_SetItem(self->pStore, nRow, nColumn, pyData);
 
-	// refresh bound table widgets
-	if (!PxDynaset_RefreshBoundWidgets(self, false, true, false))
+	pyRowData = PyStructSequence_GET_ITEM(PyList_GET_ITEM(self->pyRows, nRow), PXDYNASETROW_DATA);
+	if (nColumn < 0 || nColumn >= PyTuple_GET_SIZE(pyRowData)) {
+		PyErr_SetString(PyExc_IndexError, "Cannot set data in Dynaset. Column index out of range.");
 		return false;
+	}
+	pyDataOld = PyTuple_GET_ITEM(pyRowData, nColumn);
+	Py_INCREF(pyData);
+	PyTuple_SET_ITEM(pyRowData, nColumn, pyData);
+	Py_XDECREF(pyDataOld);
 	return true;
 }
 
 static PyObject* // new ref
-PxDynaset_clear(PxDynasetObject* self, PyObject* args)
-{
-	if (!PxDynaset_Clear(self))
-		return NULL;
-	Py_RETURN_NONE;
-}
-
-PyObject* // new ref
-PxDynaset_execute(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+PxDynaset_GetRowTuple(PxDynasetObject* self, Py_ssize_t nRow)
 {
-	static char *kwlist[] = { "parameters", "query", NULL };
-	PyObject* pyParameters = NULL, *pyQuery = NULL, *pyResult = NULL;
-	if (args && !PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &pyParameters, &pyQuery)) {
-		return NULL;
-	}
-
-	if (pyParameters) {
-		if (!PyDict_Check(pyParameters)) {
-			PyErr_SetString(PyExc_TypeError, "Parameter 1 ('parameters') must be a dict.");
-			return NULL;
-		}
-	}
-	else if (self->pyParent) {
-		PyObject* pyColumn, *pyParentDynasetColumn, *pyParentDynasetColumnName, *pyColumnName, *pyData;
-		Py_ssize_t nPos = 0;
-		pyParameters = PyDict_New();
-
-		while (PyDict_Next(self->pyColumns, &nPos, &pyColumnName, &pyColumn)) {
-			if (PyErr_Occurred()) {
-				PyErr_Print();
-				return NULL;
-			}
-			pyParentDynasetColumn = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_PARENT);
-			if (pyParentDynasetColumn != Py_None) {
-				pyData = PxDynaset_GetData(self->pyParent, self->pyParent->nRow, pyParentDynasetColumn);
-				pyParentDynasetColumnName = PyStructSequence_GetItem(pyParentDynasetColumn, PXDYNASETCOLUMN_NAME);
-				if (PyDict_SetItem(pyParameters, pyParentDynasetColumnName /*pyColumnName*/, pyData) == -1) {
-					return NULL;
-				}
-			}
-		}
-
-		if (PyDict_Size(pyParameters) == 0) {
-			Py_DECREF(pyParameters);
-			pyParameters = NULL;
-		}
-	}
+	PyObject* pyRowData;
 
-	if (pyQuery) {
-		if (PyUnicode_Check(pyQuery))
-			PxAttachObject(&self->pyQuery, pyQuery, true);
-		else {
-			PyErr_SetString(PyExc_TypeError, "Parameter 2 ('query') must be a string.");
-			return NULL;
-		}
-	}
+	if (self->pStore)
+		return PxColumnStore_GetRowData(self->pStore, nRow);
 
-	if (!PxDynaset_Clear(self))
-		return NULL;
+	pyRowData = PyStructSequence_GET_ITEM(PyList_GET_ITEM(self->pyRows, nRow), PXDYNASETROW_DATA);
+	Py_INCREF(pyRowData);
+	return pyRowData;
+}
 
-	if (self->pyCursor && PyObject_CallMethod(self->pyCursor, "close", NULL) == NULL)
-		return NULL;
+static PyObject* // new ref
+PxDynaset_GetOldRowTuple(PxDynasetObject* self, Py_ssize_t nRow)
+// data before modification, None if the row is unmodified, put together from the edit journal
+{
+	PyObject* pyRowData, *pyRowDataOld, *pyData;
+	PxJournalEntry* pEntry;
+	Py_ssize_t n;
 
-	if ((self->pyCursor = PyObject_CallMethod(self->pyConnection, "cursor", NULL)) == NULL) {
+	if (!(PxDynaset_GetRowState(self, nRow) & PxROW_MODIFIED))
+		Py_RETURN_NONE;
+	if ((pyRowData = PxDynaset_GetRowTuple(self, nRow)) == NULL)
 		return NULL;
-	}
-
-	const char* sQuery = PyUnicode_AsUTF8(self->pyQuery);
-	if (pyParameters)
-		pyResult = PyObject_CallMethod(self->pyCursor, "execute", "(sO)", sQuery, pyParameters);
-	else
-		pyResult = PyObject_CallMethod(self->pyCursor, "execute", "(s)", sQuery);
-	if (pyResult == NULL) {
+	pyRowDataOld = (PyObject*)PyTuple_Duplicate((PyTupleObject*)pyRowData);
+	Py_DECREF(pyRowData);
+	if (pyRowDataOld == NULL)
 		return NULL;
+	for (n = self->nJournalPosition - 1; n >= 0; n--) { // the oldest value of a cell is written last
+		pEntry = self->pJournal + n;
+		if (pEntry->nRow != nRow)
+			continue;
+		pyData = PyTuple_GET_ITEM(pyRowDataOld, pEntry->nColumn);
+		Py_INCREF(pEntry->pyData);
+		PyTuple_SET_ITEM(pyRowDataOld, pEntry->nColumn, pEntry->pyData);
+		Py_DECREF(pyData);
 	}
+	return pyRowDataOld;
+}
 
-	PyObject* pyColumnDescriptions = PyObject_GetAttrString(self->pyCursor, "description");
-	PyObject* pyIterator = PyObject_GetIter(pyColumnDescriptions);
-	PyObject* pyItem, *pyColumnName, *pyColumn, *pyIndex;
-	Py_ssize_t nIndex = 0;
-	if (pyIterator == NULL) {
-		return NULL;
-	}
+// Edit journal
+// Every cell edit records the row, the column and the value it replaces, so edits can be undone and redone one at a time across rows.
+// Entries follow their rows when rows are inserted, removed or sorted. Saving or reloading the rows forgets them.
 
-	// make my columns' index numbers point to correct position in query result tuples
-	while (pyItem = PyIter_Next(pyIterator)) {
-		pyColumnName = PyTuple_GetItem(pyItem, 0);
-		if (pyColumnName == NULL)
-			return NULL;
+static void
+PxDynaset_SetModified(PxDynasetObject* self, Py_ssize_t nRow, bool bModified)
+// rows kept as tuples mark a modification by True in place of dataOld, the values before are in the journal
+{
+	PyObject* pyRow, *pyFlag, *pyFlagOld;
 
-		pyColumn = PyDict_GetItem(self->pyColumns, pyColumnName);
-		if (pyColumn != NULL) {
-			pyIndex = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX);
-			Py_DECREF(pyIndex);
-			PyStructSequence_SetItem(pyColumn, PXDYNASETCOLUMN_INDEX, PyLong_FromSsize_t(nIndex));
-		}
-		else {
-			return PyErr_Format(PyExc_AttributeError, "Column '%s' of query not contained in Dynaset's column list.", PyUnicode_AsUTF8(pyColumnName));
-		}
-		nIndex++;
-		Py_DECREF(pyItem);
+	if (self->pStore) {
+		if (bModified)
+			self->pStore->pState[nRow] |= PxROW_MODIFIED;
+		else
+			self->pStore->pState[nRow] &= ~PxROW_MODIFIED;
+		return;
 	}
-	Py_DECREF(pyIterator);
 
-	// create Dynaset rows and reference to query result tuples
-	PyObject* pyRow = NULL;
-	self->nRows = 0;
-	while (pyItem = PyIter_Next(pyResult)) {
-		//Py_INCREF(pyItem); // ??
-		Py_INCREF(Py_None);
-		Py_INCREF(Py_False);
-		Py_INCREF(Py_False);
-		pyRow = PyStructSequence_New(&PxDynasetRowType);
-		PyStructSequence_SetItem(pyRow, PXDYNASETROW_DATA, pyItem);
-		PyStructSequence_SetItem(pyRow, PXDYNASETROW_DATAOLD, Py_None);
-		PyStructSequence_SetItem(pyRow, PXDYNASETROW_NEW, Py_False);
-		PyStructSequence_SetItem(pyRow, PXDYNASETROW_DELETE, Py_False);
-
-		if (PyList_Append(self->pyRows, pyRow) == -1) {
-			return NULL;
-		}
-        Py_DECREF(pyRow);
-		self->nRows++;
-	}
-	Py_DECREF(pyResult);
-	Py_DECREF(pyColumnDescriptions);
-	if (self->pyParent)
-		Py_XDECREF(pyParameters);
+	pyRow = PyList_GET_ITEM(self->pyRows, nRow);
+	pyFlagOld = PyStructSequence_GET_ITEM(pyRow, PXDYNASETROW_DATAOLD);
+	pyFlag = bModified ? Py_True : Py_None;
+	Py_INCREF(pyFlag);
+	PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DATAOLD, pyFlag);
+	Py_DECREF(pyFlagOld);
+}
 
-	if (PyErr_Occurred()) {
-		return NULL;
-	}
+static void
+PxDynaset_ForgetJournal(PxDynasetObject* self)
+{
+	Py_ssize_t n;
 
-	// notify table widgets
-	if (!PxDynaset_RefreshBoundWidgets(self, false, true, false))
-		return NULL;
+	for (n = 0; n < self->nJournal; n++)
+		Py_DECREF(self->pJournal[n].pyData);
+	PyMem_RawFree(self->pJournal);
+	self->pJournal = NULL;
+	self->nJournal = self->nJournalPosition = self->nJournalCapacity = 0;
+}
 
-	if (self->pyOnChangedCB) {
-		PyObject* pyArgs = Py_BuildValue("(OiO)", (PyObject*)self, -1,Py_None);
-		pyResult = PyObject_CallObject(self->pyOnChangedCB, pyArgs);
-		Py_XDECREF(pyArgs);
-		if (pyResult == NULL)
+static bool
+PxDynaset_JournalEdit(PxDynasetObject* self, Py_ssize_t nRow, Py_ssize_t nColumn, PyObject* pyData)
+// put pyData into the cell and record the value it replaces, the row is marked modified unless it is new, edits undone before cannot be redone any more
+// A failed edit leaves the row and the journal as they were.
+{
+	PxJournalEntry* pJournal, *pEntry;
+	PyObject* pyDataOld;
+	Py_ssize_t nCapacity;
+	unsigned char cState = PxDynaset_GetRowState(self, nRow);
+
+	if (self->nJournalPosition == self->nJournalCapacity) {
+		nCapacity = self->nJournalCapacity ? self->nJournalCapacity * 2 : 64;
+		if ((pJournal = (PxJournalEntry*)PyMem_RawRealloc(self->pJournal, nCapacity * sizeof(PxJournalEntry))) == NULL) {
+			PyErr_NoMemory();
 			return false;
-		else {
-			Py_XDECREF(pyResult);
 		}
+		self->pJournal = pJournal;
+		self->nJournalCapacity = nCapacity;
 	}
-
-	return PyLong_FromSsize_t(self->nRows);
+	if ((pyDataOld = PxDynaset_GetCell(self, nRow, nColumn)) == NULL)
+		return false;
+	// a row listed as dirty but unmodified is pruned by HasDirtyRows, so the listing may come first
+	if ((!(cState & (PxROW_NEW | PxROW_MODIFIED)) && !PxDynaset_MarkDirty(self, nRow)) ||
+		!PxDynaset_PutCell(self, nRow, nColumn, pyData)) {
+		Py_DECREF(pyDataOld);
+		return false;
+	}
+	if (!(cState & (PxROW_NEW | PxROW_MODIFIED)))
+		PxDynaset_SetModified(self, nRow, true);
+
+	while (self->nJournal > self->nJournalPosition)
+		Py_DECREF(self->pJournal[--self->nJournal].pyData);
+	pEntry = self->pJournal + self->nJournal++;
+	pEntry->nRow = nRow;
+	pEntry->nColumn = nColumn;
+	pEntry->pyData = pyDataOld;
+	pEntry->cState = cState;
+	self->nJournalPosition = self->nJournal;
+	return true;
 }
 
-PyObject* // new ref
-PxDynaset_GetRowDataDict(PxDynasetObject* self, Py_ssize_t nRow, bool bKeysOnly)
+static Py_ssize_t
+PxDynaset_RowsBelow(const Py_ssize_t* pnRows, Py_ssize_t nCount, Py_ssize_t nRow)
+// number of rows in the ascending list lower than nRow
 {
-	PyObject* pyColumnName, *pyColumn, *pyRow, *pyRowData, *pyData, *pyIsKey, *pyRowDataDict;
-	Py_ssize_t nColumn, nPos = 0;
-	if (nRow == -1)
-		nRow = self->nRow;
-	if (nRow == -1)
-		Py_RETURN_NONE;
-	pyRow = PyList_GetItem(self->pyRows, nRow);
-	pyRowData = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATA);
-	pyRowDataDict = PyDict_New();
+	Py_ssize_t nLow = 0, nHigh = nCount, nMiddle;
 
-	while (PyDict_Next(self->pyColumns, &nPos, &pyColumnName, &pyColumn)) {
-		if (PyErr_Occurred()) {
-			PyErr_Print();
-			return NULL;
-		}
-		nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-		pyIsKey = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_KEY);
-		pyData = PyTuple_GetItem(pyRowData, nColumn);
-		//XX(pyData);
-		if (!bKeysOnly || pyIsKey == Py_True)
-			if (PyDict_SetItem(pyRowDataDict, pyColumnName, pyData) == -1) // PyDict_SetItem increfs...
-				return NULL;
+	while (nLow < nHigh) {
+		nMiddle = (nLow + nHigh) / 2;
+		if (pnRows[nMiddle] < nRow)
+			nLow = nMiddle + 1;
+		else
+			nHigh = nMiddle;
 	}
-	return pyRowDataDict;
+	return nLow;
 }
 
-static bool
-PxDynaset_UpdateAutoColumnInChildren(PxDynasetObject* self, PyObject* pyParentColumn, PyObject* pyLastRowID)
+static void
+PxDynaset_JournalDropRows(PxDynasetObject* self, const Py_ssize_t* pnRows, Py_ssize_t nCount, bool bRenumber)
+// drop the entries of the rows listed in ascending order, with bRenumber the rows are gone and the others move up
 {
-	PyObject* pyColumnName, *pyColumn, *pyRow, *pyRowData;
-	PxDynasetObject* pyChild;
-	Py_ssize_t n, nLen, nRows, nRow, nPos;
-
-	nLen = PySequence_Size(self->pyChildren);
-	for (n = 0; n < nLen; n++) {
-		pyChild = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
-		while (PyDict_Next(pyChild->pyColumns, &nPos, &pyColumnName, &pyColumn)) {
-			if (PyErr_Occurred()) {
-				PyErr_Print();
-				return false;
-			}
-			if (PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_PARENT) == pyParentColumn) {
-				nRows = PySequence_Size(pyChild->pyRows);
-				for (nRow = 0; nRow < nRows; nRow++) {
-					pyRow = PyList_GetItem(pyChild->pyRows, nRow);
-					pyRowData = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATA);
-					PyTuple_SET_ITEM(pyRowData, nPos, pyLastRowID);
-				}
-				PxDynaset_UpdateAutoColumnInChildren(pyChild, pyColumn, pyLastRowID);
-			}
+	Py_ssize_t n, nTo = 0, nBelow, nPosition = self->nJournalPosition;
+	PxJournalEntry* pEntry;
+
+	for (n = 0; n < self->nJournal; n++) {
+		pEntry = self->pJournal + n;
+		nBelow = PxDynaset_RowsBelow(pnRows, nCount, pEntry->nRow);
+		if (nBelow < nCount && pnRows[nBelow] == pEntry->nRow) {
+			Py_DECREF(pEntry->pyData);
+			if (n < nPosition)
+				self->nJournalPosition--;
+			continue;
 		}
+		if (bRenumber)
+			pEntry->nRow -= nBelow;
+		self->pJournal[nTo++] = *pEntry;
 	}
+	self->nJournal = nTo;
 }
 
-bool
-PxDynaset_Save(PxDynasetObject* self)
+static bool
+PxDynaset_JournalPermute(PxDynasetObject* self, const Py_ssize_t* pnOrder)
+// renumber the entries after row n has become the former row pnOrder[n]
 {
-	int iRecordsChanged = 0;
-	PyObject* pyOk;
-	char sMessage[30];
+	Py_ssize_t* pnNewRow, n;
 
-	iRecordsChanged = PxDynaset_Write(self);
-	if (iRecordsChanged == -1) {
-		pyOk = PyObject_CallMethod(self->pyConnection, "rollback", NULL);
-		if (pyOk != NULL)
-			Py_DECREF(pyOk);
+	if (self->nJournal == 0)
+		return true;
+	if ((pnNewRow = (Py_ssize_t*)PyMem_RawMalloc(self->nRows * sizeof(Py_ssize_t))) == NULL) {
+		PyErr_NoMemory();
 		return false;
 	}
-	else {
-		pyOk = PyObject_CallMethod(self->pyConnection, "commit", NULL);
-		if (pyOk == NULL)
-			return false;
-		else {
-			Py_DECREF(pyOk);
-			if (!PxDynaset_CleanUp(self))
-				return false;
-			if (!PxDynaset_Thaw(self))
-				return false;
-			sprintf(sMessage, "Records updated: %d", iRecordsChanged);
-			gtk_statusbar_push(g.gtkStatusbar, 1, sMessage);
-		}
-	}
+	for (n = 0; n < self->nRows; n++)
+		pnNewRow[pnOrder[n]] = n;
+	for (n = 0; n < self->nJournal; n++)
+		self->pJournal[n].nRow = pnNewRow[self->pJournal[n].nRow];
+	PyMem_RawFree(pnNewRow);
 	return true;
 }
 
+static PyObject* // borrowed ref
+PxDynaset_DataColumn(PxDynasetObject* self, Py_ssize_t nColumn)
+// the DynasetColumn at position nColumn in the row data, NULL if none
+{
+	Py_ssize_t n;
+	for (n = 0; n < self->nColumnInfo; n++)
+		if (self->pColumnInfo[n].nIndex == nColumn)
+			return self->pColumnInfo[n].pyColumn;
+	return NULL;
+}
+
 static int
-PxDynaset_Write(PxDynasetObject* self)
+PxDynaset_Replay(PxDynasetObject* self, bool bRedo)
+// undo the latest edit in effect or redo the earliest one undone, 0 if there is none
 {
-	PyObject* pyResult, *pyColumnName, *pyColumn, *pyRow, *pyRowData, *pyRowDataOld, *pyRowDelete, *pyRowNew, *pyData, *pyIsKey, *pyParams, *pyCursor, *pyLastRowID, *tmp;
-	Py_ssize_t nRow, nColumn, nPos;
-	int iRecordsChanged = 0;
-	int iChildRecordsChanged = 0;
-	char* sSql;
-	char* sSql2;
-	PxDynasetObject* pyChild;
-	Py_ssize_t n, nLen;
+	PxJournalEntry* pEntry;
+	PyObject* pyData;
+	unsigned char cState;
 
-	if (self->pyBeforeSaveCB) {
-		PyObject* pyArgs = PyTuple_Pack(1, (PyObject*)self);
-		//Py_INCREF(self);
-		PyObject* pyResult = PyObject_CallObject(self->pyBeforeSaveCB, pyArgs);
-		Py_DECREF(pyArgs);
-		if (pyResult == NULL)
+	if (bRedo ? self->nJournalPosition == self->nJournal : self->nJournalPosition == 0)
+		return 0;
+	pEntry = self->pJournal + (bRedo ? self->nJournalPosition : self->nJournalPosition - 1);
+
+	if ((pyData = PxDynaset_GetCell(self, pEntry->nRow, pEntry->nColumn)) == NULL)
+		return -1;
+	if (!PxDynaset_PutCell(self, pEntry->nRow, pEntry->nColumn, pEntry->pyData)) {
+		Py_DECREF(pyData);
+		return -1;
+	}
+	Py_SETREF(pEntry->pyData, pyData); // what the other direction restores
+
+	cState = PxDynaset_GetRowState(self, pEntry->nRow);
+	if ((cState ^ pEntry->cState) & PxROW_MODIFIED) {
+		if ((pEntry->cState & PxROW_MODIFIED) && !PxDynaset_MarkDirty(self, pEntry->nRow))
 			return -1;
-		//else if (pyResult == Py_False) {
-		//	Py_DECREF(pyResult);
-		//	return 0;
-		//}
-		else Py_DECREF(pyResult);
+		PxDynaset_SetModified(self, pEntry->nRow, pEntry->cState & PxROW_MODIFIED);
 	}
+	pEntry->cState = cState;
+	self->nJournalPosition += bRedo ? 1 : -1;
 
-	// iterate over own rows
-	nLen = PySequence_Size(self->pyRows);
-	for (nRow = 0; nRow < nLen; nRow++) {
-		pyRow = PyList_GetItem(self->pyRows, nRow);
-		pyRowData = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATA);
-		pyRowDataOld = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATAOLD);
-		pyRowDelete = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DELETE);
-		pyRowNew = PyStructSequence_GetItem(pyRow, PXDYNASETROW_NEW);
-		pyParams = PyList_New(0);
-		nPos = 0;
+	if (!PxDynaset_DataChanged(self, pEntry->nRow, PxDynaset_DataColumn(self, pEntry->nColumn)))
+		return -1;
+	if (PxDynaset_HasDirtyRows(self))
+		return PxDynaset_Stain(self) ? 1 : -1;
+	return PxDynaset_Thaw(self) && PxDynaset_UnStain(self) ? 1 : -1;
+}
 
-		// DELETE
-		if (pyRowDelete == Py_True) {
-			if (pyRowNew == Py_False) {
-				char* sArr[3] = { "DELETE FROM ", PyUnicode_AsUTF8(self->pyTable), " WHERE " };
-				sSql = StringArrayCat(sArr, 3);
-
-				while (PyDict_Next(self->pyColumns, &nPos, &pyColumnName, &pyColumn)) {
-					if (PyErr_Occurred()) {
-						PyErr_Print();
-						return -1;
-					}
-					nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-					pyIsKey = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_KEY);
-					pyData = PyTuple_GetItem(pyRowData, nColumn);
-					if (pyIsKey == Py_True) {
-						sSql = StringAppend2(sSql, PyUnicode_AsUTF8(pyColumnName), "=? AND ");
-						if (PyList_Append(pyParams, pyData) == -1) {
-							return -1;
-						}
-					}
-				}
+static bool
+PxDynaset_RevertRow(PxDynasetObject* self, Py_ssize_t nRow)
+// undo all edits of the row in effect, its entries leave the journal
+{
+	Py_ssize_t n;
 
-				memset(sSql + strlen(sSql) - 5, '\0', 1); // cut off final ' AND '
-				sSql = StringAppend2(sSql, ";", NULL);
+	for (n = self->nJournalPosition - 1; n >= 0; n--)
+		if (self->pJournal[n].nRow == nRow && !PxDynaset_PutCell(self, nRow, self->pJournal[n].nColumn, self->pJournal[n].pyData))
+			return false;
+	PxDynaset_SetModified(self, nRow, false);
+	PxDynaset_JournalDropRows(self, &nRow, 1, false);
+	return true;
+}
 
-				if (PySequence_Size(pyParams) > 0) {
-					pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(sO)", sSql, PyList_AsTuple(pyParams));
-					if (pyCursor == NULL) {
-						return -1;
-					}
-					iRecordsChanged++;
-				}
-				else {
-					PyErr_SetString(PyExc_RuntimeError, "No key columns. Can not delete.");
-					return -1;
-				}
-				Py_DECREF(pyCursor);
+// Computed column evaluation
+// Computed cells are filled in when a row is inserted and refreshed from DataChanged, for the edited row only and only where the column changed is used.
+// A column changing in turn is announced like an edit, so columns computed from computed columns follow. Computed cells are neither journaled nor saved.
 
-				if (self->sDeleteSQL)
-					PyMem_RawFree(self->sDeleteSQL);
-				self->sDeleteSQL = sSql;
+#define PxEXPR_STACK 16
 
-				Py_XDECREF(self->pyParams);
-				self->pyParams = pyParams;
+static PyObject* // new ref
+PxDynaset_Concatenate(PyObject* pyLeft, PyObject* pyRight)
+{
+	PyObject* pyLeftText, *pyRightText, *pyResult = NULL;
+
+	pyLeftText = PyObject_Str(pyLeft);
+	pyRightText = pyLeftText ? PyObject_Str(pyRight) : NULL;
+	if (pyRightText)
+		pyResult = PyUnicode_Concat(pyLeftText, pyRightText);
+	Py_XDECREF(pyLeftText);
+	Py_XDECREF(pyRightText);
+	return pyResult;
+}
 
+static PyObject* // new ref
+PxDynaset_Evaluate(PxDynasetObject* self, PxDynasetColumnInfo* pInfo, Py_ssize_t nRow)
+// run the compiled formula on row nRow; as in SQL an operand None gives None, and so does division by zero
+{
+	PyObject* pyLocal[PxEXPR_STACK], **ppyStack, *pyLeft, *pyRight, *pyResult = NULL;
+	PxExprStep* pStep;
+	Py_ssize_t nDepth = 0, nColumn, n;
+	int iZero;
+
+	if (pInfo->nSteps <= PxEXPR_STACK)
+		ppyStack = pyLocal;
+	else if ((ppyStack = (PyObject**)PyMem_RawMalloc(pInfo->nSteps * sizeof(PyObject*))) == NULL)
+		return PyErr_NoMemory();
+
+	for (pStep = pInfo->pSteps; pStep < pInfo->pSteps + pInfo->nSteps; pStep++) {
+		switch (pStep->iOperation) {
+		case PxEXPR_COLUMN:
+			if ((nColumn = self->pColumnInfo[pStep->nArgument].nIndex) == -1) {
+				pyResult = Py_None;
+				Py_INCREF(Py_None);
 			}
-		}
-		// INSERT
-		else if (pyRowNew == Py_True) {
-			//g_debug("INSERT");
-			char* sArr[3] = { "INSERT INTO ", PyUnicode_AsUTF8(self->pyTable), " (" };
-			sSql = StringArrayCat(sArr, 3);
-			sSql2 = StringAppend(NULL, ") VALUES (");
-
-			while (PyDict_Next(self->pyColumns, &nPos, &pyColumnName, &pyColumn)) {
-				if (PyErr_Occurred()) {
-					PyErr_Print();
-					return -1;
-				}
-				nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-				pyIsKey = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_KEY);
-				pyData = PyTuple_GetItem(pyRowData, nColumn);
-
-				if (pyIsKey != Py_None && self->pyAutoColumn != pyColumn) {
-					sSql = StringAppend2(sSql, PyUnicode_AsUTF8(pyColumnName), ",");
-					sSql2 = StringAppend(sSql2, "?,");
-					if (PyList_Append(pyParams, pyData) == -1) {
-						return -1;
-					}
-				}
-				//Py_DECREF(pyData);
+			else
+				pyResult = PxDynaset_GetCell(self, nRow, nColumn);
+			break;
+
+		case PxEXPR_CONSTANT:
+			pyResult = pStep->pyValue;
+			Py_INCREF(pyResult);
+			break;
+
+		case PxEXPR_NEGATE:
+			pyLeft = ppyStack[--nDepth];
+			if (pyLeft == Py_None) {
+				pyResult = Py_None;
+				Py_INCREF(Py_None);
 			}
-
-			if (PySequence_Size(pyParams) == 0) {
-				PyErr_SetString(PyExc_RuntimeError, "No columns.");
-				return -1;
+			else
+				pyResult = PyNumber_Negative(pyLeft);
+			Py_DECREF(pyLeft);
+			break;
+
+		case PxEXPR_COALESCE:
+			nDepth -= pStep->nArgument;
+			pyResult = NULL;
+			for (n = nDepth; n < nDepth + pStep->nArgument; n++) {
+				if (pyResult == NULL && (ppyStack[n] != Py_None || n == nDepth + pStep->nArgument - 1))
+					pyResult = ppyStack[n];
+				else
+					Py_DECREF(ppyStack[n]);
 			}
-
-			memset(sSql + strlen(sSql) - 1, '\0', 1); // cut off final comma
-			memset(sSql2 + strlen(sSql2) - 1, '\0', 1);
-			sSql = StringAppend2(sSql, sSql2, ");");
-
-			//XX(pyParams);
-			pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(sO)", sSql, PyList_AsTuple(pyParams));
-			if (pyCursor == NULL) {
-				PyErr_Print();
-				return -1;
+			break;
+
+		default:
+			pyRight = ppyStack[--nDepth];
+			pyLeft = ppyStack[--nDepth];
+			if (pyLeft == Py_None || pyRight == Py_None) {
+				pyResult = Py_None;
+				Py_INCREF(Py_None);
 			}
-
-			if (self->pyAutoColumn) {
-				pyLastRowID = PyObject_GetAttrString(pyCursor, "lastrowid");
-				if (pyLastRowID == NULL) {
-					PyErr_Print();
-					return -1;
-				}
-				if (pyLastRowID == Py_None) {
-					self->iLastRowID = -1;
-					Py_XDECREF(pyLastRowID);
-				}
-				else {
-					nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(self->pyAutoColumn, PXDYNASETCOLUMN_INDEX));
-					tmp = PyTuple_GetItem(pyRowData, nColumn);
-					PyTuple_SET_ITEM(pyRowData, nColumn, pyLastRowID);
-					self->iLastRowID = PyLong_AsLong(pyLastRowID);
-					Py_XDECREF(tmp);
-					PxDynaset_UpdateAutoColumnInChildren(self, self->pyAutoColumn, pyLastRowID);
+			else if (pStep->iOperation == PxEXPR_ADD)
+				pyResult = PyNumber_Add(pyLeft, pyRight);
+			else if (pStep->iOperation == PxEXPR_SUBTRACT)
+				pyResult = PyNumber_Subtract(pyLeft, pyRight);
+			else if (pStep->iOperation == PxEXPR_MULTIPLY)
+				pyResult = PyNumber_Multiply(pyLeft, pyRight);
+			else if (pStep->iOperation == PxEXPR_DIVIDE) {
+				if ((iZero = PyObject_Not(pyRight)) == 1) {
+					pyResult = Py_None;
+					Py_INCREF(Py_None);
 				}
+				else
+					pyResult = (iZero == 0) ? PyNumber_TrueDivide(pyLeft, pyRight) : NULL;
 			}
-
-			iRecordsChanged++;
-			Py_DECREF(pyCursor);
-
-			if (self->sInsertSQL)
-				PyMem_RawFree(self->sInsertSQL);
-			self->sInsertSQL = sSql;
-			PyMem_RawFree(sSql2);
-
-			Py_XDECREF(self->pyParams);
-			self->pyParams = pyParams;
-			Py_DECREF(pyRowNew); // Py_True
-			//PyStructSequence_SetItem(pyRow, PXDYNASETROW_NEW, Py_False);
+			else
+				pyResult = PxDynaset_Concatenate(pyLeft, pyRight);
+			Py_DECREF(pyLeft);
+			Py_DECREF(pyRight);
 		}
-		// UPDATE
-		else if (pyRowDataOld != Py_None) {
-			sSql = StringAppend(NULL, "UPDATE ");  // allocate on heap
-			sSql = StringAppend2(sSql, PyUnicode_AsUTF8(self->pyTable), " SET ");
-			sSql2 = StringAppend(NULL, " WHERE ");
-			PyObject* pyParams2 = PyList_New(0);
-			PyObject* pyParams1 = pyParams;
-
-			while (PyDict_Next(self->pyColumns, &nPos, &pyColumnName, &pyColumn)) {
-				if (PyErr_Occurred()) {
-					PyErr_Print();
-					return -1;
-				}
-				nColumn = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-				pyIsKey = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_KEY);
-				pyData = PyTuple_GetItem(pyRowData, nColumn);
-				if (pyIsKey == Py_False) {
-					sSql = StringAppend2(sSql, PyUnicode_AsUTF8(pyColumnName), "=?,");
-					if (PyList_Append(pyParams1, pyData) == -1) {
-						return -1;
-					}
-				}
-				else if (pyIsKey == Py_True) {
-					sSql2 = StringAppend2(sSql2, PyUnicode_AsUTF8(pyColumnName), "=? AND ");
-					if (PyList_Append(pyParams2, pyData) == -1) {
-						return -1;
-					}
-				}
-			}
+		if (pyResult == NULL)
+			break;
+		ppyStack[nDepth++] = pyResult;
+	}
 
-			if ((pyParams = PySequence_Concat(pyParams1, pyParams2)) == NULL)
-				return -1;
-			Py_XDECREF(pyParams1);
-			Py_XDECREF(pyParams2);
+	if (pyResult) // the formula leaves its value as the only item on the stack
+		nDepth--;
+	while (nDepth > 0)
+		Py_DECREF(ppyStack[--nDepth]);
+	if (ppyStack != pyLocal)
+		PyMem_RawFree(ppyStack);
+	return pyResult;
+}
 
-			if (PySequence_Size(pyParams) == 0) {
-				PyErr_SetString(PyExc_RuntimeError, "No key columns given. Can not update.");
-				return -1;
-			}
+static PyObject* // new ref
+PxDynaset_ComputeCell(PxDynasetObject* self, PxDynasetColumnInfo* pInfo, Py_ssize_t nRow)
+// value of a computed column for row nRow, a callable gets the row as DynasetRowProxy
+{
+	PyObject* pyData, *pyRow;
 
-			memset(sSql + strlen(sSql) - 1, '\0', 1); // cut off final comma
-			memset(sSql2 + strlen(sSql2) - 5, '\0', 1); // cut off final ' AND '
-			sSql = StringAppend2(sSql, sSql2, ";");
+	if (pInfo->pSteps)
+		pyData = PxDynaset_Evaluate(self, pInfo, nRow);
+	else {
+		if ((pyRow = PxDynaset_RowProxy(self, nRow)) == NULL)
+			return NULL;
+		pyData = PyObject_CallFunctionObjArgs(pInfo->pyExpr, pyRow, NULL);
+		Py_DECREF(pyRow);
+	}
+	// Quantity * Price of two int columns still fills a float column with floats, so a columnar Dynaset keeps it native
+	if (pyData && PyLong_CheckExact(pyData) && PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_TYPE) == (PyObject*)&PyFloat_Type)
+		Py_SETREF(pyData, PyNumber_Float(pyData));
+	return pyData;
+}
 
-			pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(sO)", sSql, PyList_AsTuple(pyParams));
-			PyErr_Print();
-			if (pyCursor == NULL) {
-				return -1;
-			}
-			iRecordsChanged++;
+static bool
+PxDynaset_Compute(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn, bool bNotify)
+// refresh the computed cells of row nRow using pyColumn, all of them if NULL; bNotify announces each cell refreshed
+{
+	PxDynasetColumnInfo* pInfo, *pChanged = NULL;
+	PyObject* pyData;
+	bool bOk;
+
+	if (pyColumn && (pChanged = PxDynaset_FindColumn(self, pyColumn)) == NULL)
+		return true;
+	for (pInfo = self->pColumnInfo; pInfo < self->pColumnInfo + self->nColumnInfo; pInfo++) {
+		if (pInfo->pyExpr == NULL || pInfo->nIndex == -1 || pInfo == pChanged)
+			continue;
+		if (pChanged && !PxDynaset_DependsOn(self, pInfo, pChanged))
+			continue;
+		if ((pyData = PxDynaset_ComputeCell(self, pInfo, nRow)) == NULL)
+			return false;
+		bOk = PxDynaset_PutCell(self, nRow, pInfo->nIndex, pyData);
+		Py_DECREF(pyData);
+		if (!bOk || (bNotify && !PxDynaset_DataChanged(self, nRow, pInfo->pyColumn)))
+			return false;
+	}
+	return true;
+}
+
+static PyObject* // new ref
+PxDynaset_WidenRow(PxDynasetObject* self, PyObject* pyRowData)
+// copy of the row data with an item for each data column, computed columns the query does not return come last
+{
+	PyObject* pyWide, *pyData;
+	Py_ssize_t n, nSize = PyTuple_Size(pyRowData);
+
+	if (nSize == -1 || (pyWide = PyTuple_New(self->nDataColumns)) == NULL)
+		return NULL;
+	for (n = 0; n < self->nDataColumns; n++) {
+		pyData = (n < nSize) ? PyTuple_GET_ITEM(pyRowData, n) : Py_None;
+		Py_INCREF(pyData);
+		PyTuple_SET_ITEM(pyWide, n, pyData);
+	}
+	return pyWide;
+}
+
+static void
+PxDynaset_MapComputedColumns(PxDynasetObject* self)
+// computed columns not returned by the query get positions after its columns
+{
+	PxDynasetColumnInfo* pInfo;
+
+	for (pInfo = self->pColumnInfo; pInfo < self->pColumnInfo + self->nColumnInfo; pInfo++)
+		if (pInfo->pyExpr && pInfo->nIndex == -1)
+			PxDynaset_SetColumnIndex(pInfo, self->nDataColumns++);
+}
+
+// Key index
+// locate() and seek() find rows by their key values through a dict from key tuples to row numbers, built by the first lookup.
+// Rows appended are entered as they come. Anything moving rows or changing key values drops the index, the next lookup builds it again.
+
+static Py_ssize_t
+PxDynaset_KeyCount(PxDynasetObject* self)
+{
+	Py_ssize_t n, nKeys = 0;
+	for (n = 0; n < self->nColumnInfo; n++)
+		if (self->pColumnInfo[n].iKey == 1 && self->pColumnInfo[n].nIndex != -1)
+			nKeys++;
+	return nKeys;
+}
+
+static bool
+PxDynaset_IsKeyColumn(PxDynasetObject* self, Py_ssize_t nColumn)
+{
+	Py_ssize_t n;
+	for (n = 0; n < self->nColumnInfo; n++)
+		if (self->pColumnInfo[n].nIndex == nColumn)
+			return self->pColumnInfo[n].iKey == 1;
+	return false;
+}
+
+static bool
+PxDynaset_IndexRow(PxDynasetObject* self, Py_ssize_t nRow)
+// enter row nRow into the key index, of rows with equal keys the first one is kept
+{
+	PyObject* pyKey, *pyData, *pyRow;
+	Py_ssize_t n, nKey = 0;
+	bool bOk = false;
+
+	if ((pyKey = PyTuple_New(PxDynaset_KeyCount(self))) == NULL)
+		return false;
+	for (n = 0; n < self->nColumnInfo; n++) {
+		if (self->pColumnInfo[n].iKey != 1 || self->pColumnInfo[n].nIndex == -1)
+			continue;
+		if ((pyData = PxDynaset_GetCell(self, nRow, self->pColumnInfo[n].nIndex)) == NULL) {
+			Py_DECREF(pyKey);
+			return false;
+		}
+		PyTuple_SET_ITEM(pyKey, nKey++, pyData);
+	}
+	if ((pyRow = PyLong_FromSsize_t(nRow)) != NULL) {
+		bOk = PyDict_SetDefault(self->pyKeyIndex, pyKey, pyRow) != NULL;
+		Py_DECREF(pyRow);
+	}
+	Py_DECREF(pyKey);
+	return bOk;
+}
+
+static Py_ssize_t
+PxDynaset_Locate(PxDynasetObject* self, PyObject* pyKey)
+// row holding the tuple of key values, -1 if there is none, -2 with exception
+{
+	PyObject* pyRow;
+	Py_ssize_t nRow, nKeys;
+
+	if (!PxDynaset_FetchAll(self, "locate rows"))
+		return -2;
+	if ((nKeys = PxDynaset_KeyCount(self)) == 0) {
+		PyErr_SetString(PyExc_RuntimeError, "Locating rows needs key columns.");
+		return -2;
+	}
+	if (PyTuple_GET_SIZE(pyKey) != nKeys) {
+		PyErr_Format(PyExc_TypeError, "Dynaset has %d key columns, %d values given.", (int)nKeys, (int)PyTuple_GET_SIZE(pyKey));
+		return -2;
+	}
+
+	if (self->pyKeyIndex == NULL) {
+		if ((self->pyKeyIndex = PyDict_New()) == NULL)
+			return -2;
+		for (nRow = 0; nRow < self->nRows; nRow++)
+			if (!PxDynaset_IndexRow(self, nRow)) {
+				Py_CLEAR(self->pyKeyIndex);
+				return -2;
+			}
+	}
+	if ((pyRow = PyDict_GetItemWithError(self->pyKeyIndex, pyKey)) == NULL)
+		return PyErr_Occurred() ? -2 : -1;
+	return PyLong_AsSsize_t(pyRow);
+}
+
+static PyObject* // new ref
+PxDynaset_locate(PxDynasetObject* self, PyObject* args)
+{
+	Py_ssize_t nRow;
+
+	if ((nRow = PxDynaset_Locate(self, args)) == -2)
+		return NULL;
+	return PyLong_FromSsize_t(nRow);
+}
+
+static PyObject* // new ref
+PxDynaset_seek(PxDynasetObject* self, PyObject* args)
+{
+	Py_ssize_t nRow;
+
+	if ((nRow = PxDynaset_Locate(self, args)) == -2)
+		return NULL;
+	if (nRow == -1)
+		Py_RETURN_FALSE;
+	if (!PxDynaset_SetRow(self, nRow))
+		return NULL;
+	Py_RETURN_TRUE;
+}
+
+// Filtered view
+// While a filter is applied, tables show only the rows listed in pnVisible. Row numbers everywhere else stay those of the data.
+
+Py_ssize_t
+PxDynaset_ViewRows(PxDynasetObject* self)
+// number of rows to be shown
+{
+	return self->pnVisible ? self->nVisible : self->nRows;
+}
+
+Py_ssize_t
+PxDynaset_ViewRow(PxDynasetObject* self, Py_ssize_t nPosition)
+// row shown at nPosition
+{
+	return self->pnVisible ? self->pnVisible[nPosition] : nPosition;
+}
+
+Py_ssize_t
+PxDynaset_ViewPosition(PxDynasetObject* self, Py_ssize_t nRow)
+// where row nRow is shown, -1 if it is filtered out
+{
+	Py_ssize_t nLow = 0, nHigh, nMiddle;
+
+	if (self->pnVisible == NULL || nRow == -1)
+		return nRow;
+	nHigh = self->nVisible;
+	while (nLow < nHigh) {
+		nMiddle = (nLow + nHigh) / 2;
+		if (self->pnVisible[nMiddle] < nRow)
+			nLow = nMiddle + 1;
+		else
+			nHigh = nMiddle;
+	}
+	return (nLow < self->nVisible && self->pnVisible[nLow] == nRow) ? nLow : -1;
+}
+
+static void
+PxDynaset_DropFilter(PxDynasetObject* self)
+{
+	PyMem_RawFree(self->pnVisible);
+	self->pnVisible = NULL;
+	self->nVisible = 0;
+}
+
+static bool
+PxDynaset_ViewRowInserted(PxDynasetObject* self, Py_ssize_t nRow)
+// a row has been inserted before nRow, it is shown even if it would not pass the filter
+{
+	Py_ssize_t* pnVisible, n, nPosition = self->nVisible;
+
+	if ((pnVisible = (Py_ssize_t*)PyMem_RawRealloc(self->pnVisible, (self->nVisible + 1) * sizeof(Py_ssize_t))) == NULL) {
+		PyErr_NoMemory();
+		return false;
+	}
+	self->pnVisible = pnVisible;
+	for (n = self->nVisible - 1; n >= 0 && pnVisible[n] >= nRow; n--) {
+		pnVisible[n + 1] = pnVisible[n] + 1;
+		nPosition = n;
+	}
+	pnVisible[nPosition] = nRow;
+	self->nVisible++;
+	return true;
+}
+
+static void
+PxDynaset_ViewRowRemoved(PxDynasetObject* self, Py_ssize_t nRow)
+{
+	Py_ssize_t n, nTo = 0;
+
+	for (n = 0; n < self->nVisible; n++) {
+		if (self->pnVisible[n] == nRow)
+			continue;
+		self->pnVisible[nTo++] = self->pnVisible[n] > nRow ? self->pnVisible[n] - 1 : self->pnVisible[n];
+	}
+	self->nVisible = nTo;
+}
+
+static bool
+PxDynaset_RowInserted(PxDynasetObject* self, Py_ssize_t nRow, unsigned char cState)
+// the row lists, the journal, the view and the index follow a row stored before row nRow
+{
+	Py_ssize_t n;
+
+	if (nRow != self->nRows) {
+		Py_CLEAR(self->pyKeyIndex);
+		self->nRowGeneration++;
+	}
+	self->nRows++;
+	for (n = self->nDirty - 1; n >= 0 && self->pnDirty[n] >= nRow; n--)
+		self->pnDirty[n]++;
+	for (n = self->nSelected - 1; n >= 0 && self->pnSelected[n] >= nRow; n--)
+		self->pnSelected[n]++;
+	for (n = 0; n < self->nJournal; n++)
+		if (self->pJournal[n].nRow >= nRow)
+			self->pJournal[n].nRow++;
+	if (cState && !PxDynaset_MarkDirty(self, nRow))
+		return false;
+	if (self->pnVisible && !PxDynaset_ViewRowInserted(self, nRow))
+		return false;
+	if (self->nComputed && !PxDynaset_Compute(self, nRow, NULL, false))
+		return false;
+	return self->pyKeyIndex == NULL || PxDynaset_IndexRow(self, nRow);
+}
+
+static bool
+PxDynaset_InsertRow(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyRowData, unsigned char cState)
+// insert a data tuple before row nRow, nRow == nRows appends
+{
+	PyObject* pyRow, *pyFlag, *pyWide = NULL;
+	int iResult;
+
+	if (self->nComputed) { // the row gets its own data, which the computed cells are written into
+		if ((pyWide = PxDynaset_WidenRow(self, pyRowData)) == NULL)
+			return false;
+		pyRowData = pyWide;
+	}
+	if (self->pStore) {
+		if (!PxColumnStore_InsertRow(self->pStore, nRow, pyRowData, cState))
+			goto ERROR;
+	}
+	else {
+		if ((pyRow = PyStructSequence_New(&PxDynasetRowType)) == NULL)
+			goto ERROR;
+		Py_INCREF(pyRowData);
+		PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DATA, pyRowData);
+		Py_INCREF(Py_None);
+		PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DATAOLD, Py_None);
+		pyFlag = (cState & PxROW_NEW) ? Py_True : Py_False;
+		Py_INCREF(pyFlag);
+		PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_NEW, pyFlag);
+		pyFlag = (cState & PxROW_DELETE) ? Py_True : Py_False;
+		Py_INCREF(pyFlag);
+		PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DELETE, pyFlag);
+
+		iResult = PyList_Insert(self->pyRows, nRow, pyRow);
+		Py_DECREF(pyRow);
+		if (iResult == -1)
+			goto ERROR;
+	}
+	Py_CLEAR(pyWide);
+	return PxDynaset_RowInserted(self, nRow, cState);
+
+ERROR:
+	Py_XDECREF(pyWide);
+	return false;
+}
+
+static bool
+PxDynaset_AppendStatementRow(PxDynasetObject* self)
+// append the row pStatement is on, a columnar Dynaset takes it into its vectors without a tuple in between
+{
+	PyObject* pyRowData;
+	bool bOk;
+
+	if (self->pStore)
+		return PxColumnStore_AppendStatementRow(self->pStore, self->pStatement) && PxDynaset_RowInserted(self, self->nRows, 0);
+
+	if ((pyRowData = PxQuery_GetStatementRow(self->pStatement)) == NULL)
+		return false;
+	bOk = PxDynaset_InsertRow(self, self->nRows, pyRowData, 0);
+	Py_DECREF(pyRowData);
+	return bOk;
+}
+
+static bool
+PxDynaset_RemoveRow(PxDynasetObject* self, Py_ssize_t nRow)
+{
+	if (self->pStore) {
+		if (!PxColumnStore_DeleteRow(self->pStore, nRow))
+			return false;
+	}
+	else if (PyList_SetSlice(self->pyRows, nRow, nRow + 1, NULL) == -1)
+		return false;
+	Py_CLEAR(self->pyKeyIndex);
+	self->nRowGeneration++;
+	self->nRows--;
+	if (self->pnVisible)
+		PxDynaset_ViewRowRemoved(self, nRow);
+	self->nDirty = PxDynaset_SqueezeRowList(self->pnDirty, self->nDirty, &nRow, 1);
+	self->nSelected = PxDynaset_SqueezeRowList(self->pnSelected, self->nSelected, &nRow, 1);
+	PxDynaset_JournalDropRows(self, &nRow, 1, true);
+	return true;
+}
+
+static bool
+PxDynaset_RemoveRows(PxDynasetObject* self, const Py_ssize_t* pnRows, Py_ssize_t nCount)
+// remove the rows listed in ascending order, each remaining row is moved only once
+{
+	PyObject* pyRows, *pyRow;
+	Py_ssize_t nRow, nGone = 0;
+
+	if (nCount == 0)
+		return true;
+
+	if (self->pStore) {
+		if (!PxColumnStore_DeleteRows(self->pStore, pnRows, nCount))
+			return false;
+	}
+	else {
+		if ((pyRows = PyList_New(self->nRows - nCount)) == NULL)
+			return false;
+		for (nRow = 0; nRow < self->nRows; nRow++) {
+			if (nGone < nCount && pnRows[nGone] == nRow) {
+				nGone++;
+				continue;
+			}
+			pyRow = PyList_GET_ITEM(self->pyRows, nRow);
+			Py_INCREF(pyRow);
+			PyList_SET_ITEM(pyRows, nRow - nGone, pyRow);
+		}
+		Py_DECREF(self->pyRows);
+		self->pyRows = pyRows;
+	}
+	Py_CLEAR(self->pyKeyIndex);
+	self->nRowGeneration++;
+	self->nRows -= nCount;
+	if (self->pnVisible)
+		self->nVisible = PxDynaset_SqueezeRowList(self->pnVisible, self->nVisible, pnRows, nCount);
+	self->nDirty = PxDynaset_SqueezeRowList(self->pnDirty, self->nDirty, pnRows, nCount);
+	self->nSelected = PxDynaset_SqueezeRowList(self->pnSelected, self->nSelected, pnRows, nCount);
+	PxDynaset_JournalDropRows(self, pnRows, nCount, true);
+	return true;
+}
+
+static bool
+PxDynaset_CreateStore(PxDynasetObject* self, Py_ssize_t nColumns)
+// set up native row storage, typed according to the columns' declared types
+{
+	PxColumnKind* pKinds;
+	Py_ssize_t n, nColumn;
+
+	if ((pKinds = (PxColumnKind*)PyMem_RawCalloc(nColumns ? nColumns : 1, sizeof(PxColumnKind))) == NULL) {
+		PyErr_NoMemory();
+		return false;
+	}
+	for (n = 0; n < self->nColumnInfo; n++) {
+		nColumn = self->pColumnInfo[n].nIndex;
+		if (nColumn >= 0 && nColumn < nColumns)
+			pKinds[nColumn] = self->pColumnInfo[n].iKind;
+	}
+	PxColumnStore_Free(self->pStore);
+	self->pStore = PxColumnStore_New(nColumns, pKinds);
+	PyMem_RawFree(pKinds);
+	return self->pStore != NULL;
+}
+
+PyObject* // new ref
+PxDynaset_GetData(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn)
+{
+	Py_ssize_t nColumn;
+	if (nRow == -1)
+		nRow = self->nRow;
+	if (nRow >= self->nRows && !PxDynaset_FetchTo(self, nRow))
+		return NULL;
+	if (nRow < 0 || nRow >= self->nRows) {
+		PyErr_SetString(PyExc_IndexError, "Cannot get data from Dynaset. Row number out of range.");
+		return NULL;
+	}
+	if ((nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+		return NULL;
+	return PxDynaset_GetCell(self, nRow, nColumn);
+}
+
+static PyObject* // new ref
+PxDynaset_get_data(PxDynasetObject* self, PyObject *args)
+{
+	Py_ssize_t nRow = self->nRow;
+	PyObject* pyColumn, *pyData;
+	if (!PyArg_ParseTuple(args, "O|n", &pyColumn, &nRow)) {
+		return NULL;
+	}
+	if (nRow >= self->nRows && !PxDynaset_FetchTo(self, nRow))
+		return NULL;
+	if (nRow < -1 || nRow >= self->nRows) {
+		PyErr_SetString(PyExc_IndexError, "Cannot get data from Dynaset. Row number out of range.");
+		return NULL;
+	}
+
+	if (PyUnicode_Check(pyColumn)) {
+		pyData = pyColumn;
+		pyColumn = PyDict_GetItem(self->pyColumns, pyData);
+		if (!pyColumn)
+			return PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyData));
+	}
+	return PxDynaset_GetData(self, nRow, pyColumn);
+}
+
+bool
+PxDynaset_SetData(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn, PyObject* pyData)
+// pyData is borrowed
+{
+	Py_ssize_t nColumn;
+	//g_debug("*---- PxDynaset_SetData");
+	if (nRow < 0 || nRow >= self->nRows) {
+		PyErr_SetString(PyExc_IndexError, "Cannot set data in Dynaset. Row number out of range.");
+		return false;
+	}
+	if ((nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+		return false;
+	if (PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_EXPR) != Py_None) {
+		PyErr_Format(PyExc_ValueError, "Column '%s' is computed and cannot be edited.", PyUnicode_AsUTF8(PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_NAME)));
+		return false;
+	}
+	if (!PxDynaset_JournalEdit(self, nRow, nColumn, pyData))
+		return false;
+	PxDynaset_Stain(self);
+
+	return PxDynaset_DataChanged(self, nRow, pyColumn);
+}
+
+static PyObject* // new ref
+PxDynaset_set_data(PxDynasetObject* self, PyObject *args)
+{
+	Py_ssize_t nRow = self->nRow;
+	PyObject* pyColumn, *pyColumnName, *pyData;
+	if (!PyArg_ParseTuple(args, "OO|n", &pyColumn, &pyData, &nRow)) {
+		return NULL;
+	}
+	if (nRow >= self->nRows && !PxDynaset_FetchTo(self, nRow))
+		return NULL;
+	if (nRow < -1 || nRow >= self->nRows) {
+		PyErr_SetString(PyExc_IndexError, "Cannot set data in Dynaset. Row number out of range.");
+		//g_debug("PxDynaset_set_data nRow %d", nRow);
+		return NULL;
+	}
+
+	if (PyUnicode_Check(pyColumn)) {
+		pyColumnName = pyColumn;
+		pyColumn = PyDict_GetItem(self->pyColumns, pyColumnName);
+		if (!pyColumn)
+			return PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyColumnName));
+	}
+	else if (!PyObject_TypeCheck(pyColumn, &PxDynasetColumnType)) {
+		PyErr_SetString(PyExc_TypeError, "'column' must be a DataColumn.");
+		return NULL;
+	}
+
+	if (!PxDynaset_SetData(self, nRow, pyColumn, pyData))
+		return NULL;
+	Py_RETURN_NONE;
+}
+
+static PyObject* // new ref
+PxDynaset_get_row(PxDynasetObject* self, PyObject* args)
+{
+	Py_ssize_t nRow = self->nRow;
+	PyObject* pyRow = NULL;
+
+	if (!PyArg_ParseTuple(args, "|n", &nRow)) {
+		return NULL;
+	}
+	if (nRow < 0)
+		Py_RETURN_NONE;
+	if (nRow >= self->nRows && !PxDynaset_FetchTo(self, nRow))
+		return NULL;
+	if (nRow >= self->nRows) {
+		PyErr_SetString(PyExc_IndexError, "Cannot get row from Dynaset. Row number out of range.");
+		//g_debug("PxDynaset_get_row nRow %d", nRow);
+		return NULL;
+	}
+	unsigned char cState = PxDynaset_GetRowState(self, nRow);
+	if (!self->pStore && !(cState & PxROW_MODIFIED)) {
+		pyRow = PyList_GetItem(self->pyRows, nRow);
+		Py_XINCREF(pyRow);
+		return pyRow;
+	}
+
+	// columnar rows have no DynasetRow of their own and modified ones keep their old data in the journal, hand out a snapshot
+	PyObject* pyFlag;
+	if ((pyRow = PyStructSequence_New(&PxDynasetRowType)) == NULL)
+		return NULL;
+	PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DATA, PxDynaset_GetRowTuple(self, nRow));
+	PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DATAOLD, PxDynaset_GetOldRowTuple(self, nRow));
+	pyFlag = (cState & PxROW_NEW) ? Py_True : Py_False;
+	Py_INCREF(pyFlag);
+	PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_NEW, pyFlag);
+	pyFlag = (cState & PxROW_DELETE) ? Py_True : Py_False;
+	Py_INCREF(pyFlag);
+	PyStructSequence_SET_ITEM(pyRow, PXDYNASETROW_DELETE, pyFlag);
+	if (PyStructSequence_GET_ITEM(pyRow, PXDYNASETROW_DATA) == NULL) {
+		Py_DECREF(pyRow);
+		return NULL;
+	}
+	return pyRow;
+}
+
+static PyObject* // new ref
+PxDynaset_get_row_data(PxDynasetObject* self, PyObject* args)
+{
+	Py_ssize_t nRow = self->nRow;
+	PyObject* pyRow = NULL;
+
+	if (!PyArg_ParseTuple(args, "|n", &nRow)) {
+		return NULL;
+	}
+	if (nRow < 0)
+		Py_RETURN_NONE;
+	if (nRow >= self->nRows && !PxDynaset_FetchTo(self, nRow))
+		return NULL;
+	if (nRow >= self->nRows) {
+		PyErr_SetString(PyExc_IndexError, "Cannot get row data from Dynaset. Row number out of range.");
+		return NULL;
+	}
+	return PxDynaset_GetRowDataDict(self, nRow, false);
+}
+
+// Aggregates
+// Computed over the rows shown, in C loops over the native column vectors where the Dynaset is columnar.
+
+static PyObject* // borrowed ref
+PxDynaset_ColumnArgument(PxDynasetObject* self, PyObject* pyColumn)
+// the column given by name or as DynasetColumn, NULL with exception if it is not one of this Dynaset
+{
+	PyObject* pyFound;
+
+	if (PyUnicode_Check(pyColumn)) {
+		if ((pyFound = PyDict_GetItem(self->pyColumns, pyColumn)) == NULL)
+			PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyColumn));
+		return pyFound;
+	}
+	if (PxDynaset_FindColumn(self, pyColumn))
+		return pyColumn;
+	PyErr_SetString(PyExc_TypeError, "'column' must be a column of this Dynaset or its name.");
+	return NULL;
+}
+
+static PyObject* // new ref
+PxDynaset_AggregateNative(PxDynasetObject* self, Py_ssize_t nColumn, int iFunction)
+// from the column store, not for PxCOLUMN_OBJECT
+{
+	PxColumnVector* pColumn = self->pStore->pColumns + nColumn;
+	PxColumnSummary summary;
+	Py_ssize_t nDistinct;
+	bool bReal = pColumn->iKind == PxCOLUMN_REAL;
+
+	if (iFunction == PxAGGREGATE_COUNT_DISTINCT) {
+		if ((nDistinct = PxColumnStore_CountDistinct(self->pStore, nColumn, self->pnVisible, PxDynaset_ViewRows(self))) == -1)
+			return NULL;
+		return PyLong_FromSsize_t(nDistinct);
+	}
+	PxColumnStore_Summarize(self->pStore, nColumn, self->pnVisible, PxDynaset_ViewRows(self), iFunction == PxAGGREGATE_MIN || iFunction == PxAGGREGATE_MAX, &summary);
+	if (summary.bOverflow) {
+		summary.fSum += (double)summary.iSum;
+		bReal = true;
+	}
+
+	switch (iFunction) {
+	case PxAGGREGATE_COUNT:
+		return PyLong_FromSsize_t(summary.nCount);
+	case PxAGGREGATE_MIN:
+	case PxAGGREGATE_MAX:
+		if (summary.nMinRow == -1)
+			Py_RETURN_NONE;
+		return PxColumnStore_GetItem(self->pStore, iFunction == PxAGGREGATE_MIN ? summary.nMinRow : summary.nMaxRow, nColumn);
+	case PxAGGREGATE_AVG:
+		if (summary.nCount == 0 || pColumn->iKind == PxCOLUMN_TEXT)
+			Py_RETURN_NONE;
+		return PyFloat_FromDouble((bReal ? summary.fSum : (double)summary.iSum) / summary.nCount);
+	default:
+		if (pColumn->iKind == PxCOLUMN_TEXT)
+			return PyLong_FromLong(0);
+		return bReal ? PyFloat_FromDouble(summary.fSum) : PyLong_FromLongLong(summary.iSum);
+	}
+}
+
+static PyObject* // new ref
+PxDynaset_AggregateCells(PxDynasetObject* self, Py_ssize_t nColumn, int iFunction)
+// cell by cell, for rows kept as tuples and columns of mixed type
+{
+	PyObject* pyData, *pyExtreme = NULL, *pyDistinct = NULL, *pyResult = NULL;
+	Py_ssize_t n, nRows = PxDynaset_ViewRows(self), nCount = 0, nNumbers = 0;
+	long long iSum = 0, iData;
+	double fSum = 0;
+	bool bReal = false;
+	int iOverflow, iBetter;
+
+	if (iFunction == PxAGGREGATE_COUNT_DISTINCT && (pyDistinct = PySet_New(NULL)) == NULL)
+		return NULL;
+
+	for (n = 0; n < nRows; n++) {
+		if ((pyData = PxDynaset_GetCell(self, PxDynaset_ViewRow(self, n), nColumn)) == NULL)
+			goto ERROR;
+		if (pyData == Py_None) {
+			Py_DECREF(pyData);
+			continue;
+		}
+		nCount++;
+		switch (iFunction) {
+		case PxAGGREGATE_SUM:
+		case PxAGGREGATE_AVG:
+			if (PyLong_Check(pyData)) {
+				iData = PyLong_AsLongLongAndOverflow(pyData, &iOverflow);
+				if (iOverflow || (iData > 0 && iSum > LLONG_MAX - iData) || (iData < 0 && iSum < LLONG_MIN - iData)) {
+					fSum += PyLong_AsDouble(pyData);
+					bReal = true;
+				}
+				else
+					iSum += iData;
+				nNumbers++;
+			}
+			else if (PyFloat_Check(pyData)) {
+				fSum += PyFloat_AS_DOUBLE(pyData);
+				bReal = true;
+				nNumbers++;
+			}
+			break;
+		case PxAGGREGATE_MIN:
+		case PxAGGREGATE_MAX:
+			if (pyExtreme == NULL)
+				iBetter = 1;
+			else if ((iBetter = PyObject_RichCompareBool(pyData, pyExtreme, iFunction == PxAGGREGATE_MIN ? Py_LT : Py_GT)) == -1) {
+				Py_DECREF(pyData);
+				goto ERROR;
+			}
+			if (iBetter) {
+				Py_XDECREF(pyExtreme);
+				pyExtreme = pyData;
+				continue;
+			}
+			break;
+		case PxAGGREGATE_COUNT_DISTINCT:
+			if (PySet_Add(pyDistinct, pyData) == -1) {
+				Py_DECREF(pyData);
+				goto ERROR;
+			}
+			break;
+		}
+		Py_DECREF(pyData);
+	}
+
+	switch (iFunction) {
+	case PxAGGREGATE_COUNT:
+		pyResult = PyLong_FromSsize_t(nCount);
+		break;
+	case PxAGGREGATE_COUNT_DISTINCT:
+		pyResult = PyLong_FromSsize_t(PySet_GET_SIZE(pyDistinct));
+		break;
+	case PxAGGREGATE_MIN:
+	case PxAGGREGATE_MAX:
+		pyResult = pyExtreme ? pyExtreme : Py_None;
+		Py_INCREF(pyResult);
+		break;
+	case PxAGGREGATE_AVG:
+		if (nNumbers == 0) {
+			pyResult = Py_None;
+			Py_INCREF(pyResult);
+		}
+		else
+			pyResult = PyFloat_FromDouble((fSum + (double)iSum) / nNumbers);
+		break;
+	default:
+		pyResult = bReal ? PyFloat_FromDouble(fSum + (double)iSum) : PyLong_FromLongLong(iSum);
+	}
+
+ERROR:
+	Py_XDECREF(pyExtreme);
+	Py_XDECREF(pyDistinct);
+	return pyResult;
+}
+
+PyObject* // new ref
+PxDynaset_Aggregate(PxDynasetObject* self, PyObject* pyColumn, int iFunction)
+// PxAGGREGATE_ function of the column over the rows shown, None for min, max and avg of no values
+{
+	Py_ssize_t nColumn;
+	PyObject* pyResult;
+
+	if (!PxDynaset_FetchAll(self, "aggregate a column"))
+		return NULL;
+	if ((nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+		return NULL;
+
+	if (self->pStore && self->pStore->pColumns[nColumn].iKind != PxCOLUMN_OBJECT)
+		return PxDynaset_AggregateNative(self, nColumn, iFunction);
+
+	pyResult = PxDynaset_AggregateCells(self, nColumn, iFunction);
+	// a float column returns a float sum even if all cells held integers
+	if (pyResult && iFunction == PxAGGREGATE_SUM && PyLong_CheckExact(pyResult) && PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_TYPE) == (PyObject*)&PyFloat_Type)
+		Py_SETREF(pyResult, PyNumber_Float(pyResult));
+	return pyResult;
+}
+
+static PyObject* // new ref
+PxDynaset_AggregateMethod(PxDynasetObject* self, PyObject* args, int iFunction)
+{
+	PyObject* pyColumn;
+
+	if (!PyArg_ParseTuple(args, "O", &pyColumn))
+		return NULL;
+	if ((pyColumn = PxDynaset_ColumnArgument(self, pyColumn)) == NULL)
+		return NULL;
+	return PxDynaset_Aggregate(self, pyColumn, iFunction);
+}
+
+static PyObject* // new ref
+PxDynaset_sum(PxDynasetObject* self, PyObject* args)
+{
+	return PxDynaset_AggregateMethod(self, args, PxAGGREGATE_SUM);
+}
+
+static PyObject* // new ref
+PxDynaset_min(PxDynasetObject* self, PyObject* args)
+{
+	return PxDynaset_AggregateMethod(self, args, PxAGGREGATE_MIN);
+}
+
+static PyObject* // new ref
+PxDynaset_max(PxDynasetObject* self, PyObject* args)
+{
+	return PxDynaset_AggregateMethod(self, args, PxAGGREGATE_MAX);
+}
+
+static PyObject* // new ref
+PxDynaset_avg(PxDynasetObject* self, PyObject* args)
+{
+	return PxDynaset_AggregateMethod(self, args, PxAGGREGATE_AVG);
+}
+
+static PyObject* // new ref
+PxDynaset_count(PxDynasetObject* self, PyObject* args)
+{
+	return PxDynaset_AggregateMethod(self, args, PxAGGREGATE_COUNT);
+}
+
+static PyObject* // new ref
+PxDynaset_count_distinct(PxDynasetObject* self, PyObject* args)
+{
+	return PxDynaset_AggregateMethod(self, args, PxAGGREGATE_COUNT_DISTINCT);
+}
+
+static PyObject* // new ref
+PxDynaset_column_buffer(PxDynasetObject* self, PyObject* args)
+// zero-copy view of an INTEGER or REAL column over all rows, in data order and unfiltered
+{
+	PyObject* pyColumn;
+	Py_ssize_t nColumn;
+	PxColumnKind iKind;
+
+	if (!PyArg_ParseTuple(args, "O", &pyColumn))
+		return NULL;
+	if ((pyColumn = PxDynaset_ColumnArgument(self, pyColumn)) == NULL)
+		return NULL;
+	if (!PxDynaset_FetchAll(self, "expose a column buffer"))
+		return NULL;
+	if (self->pStore == NULL) {
+		PyErr_SetString(PyExc_RuntimeError, "Column buffers need a columnar Dynaset holding rows.");
+		return NULL;
+	}
+	if ((nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+		return NULL;
+	iKind = self->pStore->pColumns[nColumn].iKind;
+	if (iKind != PxCOLUMN_INTEGER && iKind != PxCOLUMN_REAL)
+		return PyErr_Format(PyExc_TypeError, "Column '%s' is not held as native integers or reals.", PyUnicode_AsUTF8(PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_NAME)));
+	return PxColumnBuffer_New(self->pStore, nColumn, false);
+}
+
+// Row selection
+// Rows selected in a Table with multiSelect set, or with select(), are listed in pnSelected and follow their rows like pnDirty does.
+// Batch operations work on the rows given, else on the selection, else on the current row, and notify the widgets once for all of them.
+
+static gint
+PxDynaset_CompareRowNumbers(gconstpointer pA, gconstpointer pB, gpointer pUserData)
+{
+	Py_ssize_t nA = *(const Py_ssize_t*)pA, nB = *(const Py_ssize_t*)pB;
+	return nA < nB ? -1 : (nA > nB);
+}
+
+static Py_ssize_t
+PxDynaset_SortRowList(Py_ssize_t* pnRows, Py_ssize_t nCount)
+// into ascending order without duplicates, returns the new length
+{
+	Py_ssize_t n, nTo = 0;
+
+	g_qsort_with_data(pnRows, (gint)nCount, sizeof(Py_ssize_t), PxDynaset_CompareRowNumbers, NULL);
+	for (n = 0; n < nCount; n++)
+		if (nTo == 0 || pnRows[nTo - 1] != pnRows[n])
+			pnRows[nTo++] = pnRows[n];
+	return nTo;
+}
+
+static void
+PxDynaset_DropSelection(PxDynasetObject* self)
+{
+	PyMem_RawFree(self->pnSelected);
+	self->pnSelected = NULL;
+	self->nSelected = 0;
+}
+
+bool
+PxDynaset_Select(PxDynasetObject* self, const Py_ssize_t* pnRows, Py_ssize_t nCount, PxWidgetObject* pySource)
+// make the rows the selection, tables other than pySource are told to show it
+{
+	Py_ssize_t* pnSelected = NULL, n, nLen;
+	PxWidgetObject* pyWidget;
+	PyObject* pyResult;
+
+	for (n = 0; n < nCount; n++)
+		if (pnRows[n] < 0 || pnRows[n] >= self->nRows) {
+			PyErr_Format(PyExc_IndexError, "Cannot select row %d. Row number out of range.", (int)pnRows[n]);
+			return false;
+		}
+	if (nCount > 0) {
+		if ((pnSelected = (Py_ssize_t*)PyMem_RawMalloc(nCount * sizeof(Py_ssize_t))) == NULL) {
+			PyErr_NoMemory();
+			return false;
+		}
+		memcpy(pnSelected, pnRows, nCount * sizeof(Py_ssize_t));
+		nCount = PxDynaset_SortRowList(pnSelected, nCount);
+	}
+	PxDynaset_DropSelection(self);
+	self->pnSelected = pnSelected;
+	self->nSelected = nCount;
+
+	nLen = PySequence_Size(self->pyWidgets);
+	for (n = 0; n < nLen; n++) {
+		pyWidget = (PxWidgetObject*)PyList_GetItem(self->pyWidgets, n);
+		if (!pyWidget->bTable || pyWidget == pySource)
+			continue;
+		if ((pyResult = PyObject_CallMethod((PyObject*)pyWidget, "refresh_selection", NULL)) == NULL)
+			return false;
+		Py_DECREF(pyResult);
+	}
+	return true;
+}
+
+static PyObject* // new ref
+PxDynaset_SelectionList(PxDynasetObject* self)
+{
+	PyObject* pySelection, *pyRow;
+	Py_ssize_t n;
+
+	if ((pySelection = PyList_New(self->nSelected)) == NULL)
+		return NULL;
+	for (n = 0; n < self->nSelected; n++) {
+		if ((pyRow = PyLong_FromSsize_t(self->pnSelected[n])) == NULL) {
+			Py_DECREF(pySelection);
+			return NULL;
+		}
+		PyList_SET_ITEM(pySelection, n, pyRow);
+	}
+	return pySelection;
+}
+
+static Py_ssize_t* // PyMem_Raw, NULL with exception
+PxDynaset_RowListArgument(PxDynasetObject* self, PyObject* pyRows, Py_ssize_t* pnCount)
+// row numbers of a sequence in ascending order without duplicates, rows not loaded yet are fetched
+{
+	PyObject* pySequence;
+	Py_ssize_t* pnRows, n, nCount, nLast = -1;
+
+	if ((pySequence = PySequence_Fast(pyRows, "'rows' must be a sequence of row numbers.")) == NULL)
+		return NULL;
+	nCount = PySequence_Fast_GET_SIZE(pySequence);
+	if ((pnRows = (Py_ssize_t*)PyMem_RawMalloc((nCount ? nCount : 1) * sizeof(Py_ssize_t))) == NULL) {
+		Py_DECREF(pySequence);
+		PyErr_NoMemory();
+		return NULL;
+	}
+	for (n = 0; n < nCount; n++) {
+		if ((pnRows[n] = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(pySequence, n))) == -1 && PyErr_Occurred())
+			goto ERROR;
+		if (pnRows[n] > nLast)
+			nLast = pnRows[n];
+	}
+	Py_DECREF(pySequence);
+	pySequence = NULL;
+	if (nLast >= self->nRows && !PxDynaset_FetchTo(self, nLast))
+		goto ERROR;
+	for (n = 0; n < nCount; n++)
+		if (pnRows[n] < 0 || pnRows[n] >= self->nRows) {
+			PyErr_Format(PyExc_IndexError, "Row number %d out of range.", (int)pnRows[n]);
+			goto ERROR;
+		}
+	*pnCount = PxDynaset_SortRowList(pnRows, nCount);
+	return pnRows;
+
+ERROR:
+	Py_XDECREF(pySequence);
+	PyMem_RawFree(pnRows);
+	return NULL;
+}
+
+static Py_ssize_t* // PyMem_Raw, NULL with exception
+PxDynaset_BatchRows(PxDynasetObject* self, PyObject* pyRows, Py_ssize_t* pnCount)
+// the rows given, else the selection, else the current row
+{
+	Py_ssize_t* pnRows;
+
+	if (pyRows && pyRows != Py_None)
+		return PxDynaset_RowListArgument(self, pyRows, pnCount);
+	if ((pnRows = (Py_ssize_t*)PyMem_RawMalloc((self->nSelected ? self->nSelected : 1) * sizeof(Py_ssize_t))) == NULL) {
+		PyErr_NoMemory();
+		return NULL;
+	}
+	if (self->nSelected) {
+		memcpy(pnRows, self->pnSelected, self->nSelected * sizeof(Py_ssize_t));
+		*pnCount = self->nSelected;
+	}
+	else {
+		pnRows[0] = self->nRow;
+		*pnCount = self->nRow == -1 ? 0 : 1;
+	}
+	return pnRows;
+}
+
+static PyObject* // new ref
+PxDynaset_select(PxDynasetObject* self, PyObject* args)
+{
+	PyObject* pyRows;
+	Py_ssize_t* pnRows, nCount = 0;
+	bool bOk;
+
+	if (!PyArg_ParseTuple(args, "O", &pyRows))
+		return NULL;
+	if (pyRows == Py_None)
+		bOk = PxDynaset_Select(self, NULL, 0, NULL);
+	else {
+		if ((pnRows = PxDynaset_RowListArgument(self, pyRows, &nCount)) == NULL)
+			return NULL;
+		bOk = PxDynaset_Select(self, pnRows, nCount, NULL);
+		PyMem_RawFree(pnRows);
+	}
+	if (!bOk)
+		return NULL;
+	Py_RETURN_NONE;
+}
+
+static PyObject* // new ref
+PxDynaset_delete_rows(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "rows", NULL };
+	PyObject* pyRows = NULL;
+	Py_ssize_t* pnRows, nCount, n, nDeleted = 0;
+	bool bOk = true;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &pyRows))
+		return NULL;
+	if ((pnRows = PxDynaset_BatchRows(self, pyRows, &nCount)) == NULL)
+		return NULL;
+	for (n = 0; n < nCount && bOk; n++) {
+		if (PxDynaset_GetRowState(self, pnRows[n]) & PxROW_DELETE)
+			continue;
+		if ((bOk = PxDynaset_SetRowFlag(self, pnRows[n], PxROW_DELETE, true)))
+			nDeleted++;
+	}
+	PyMem_RawFree(pnRows);
+	// rows flagged before a failure stay flagged, so they are announced either way
+	if (nDeleted > 0 && (!PxDynaset_Stain(self) || !PxDynaset_DataChanged(self, -1, NULL)))
+		return NULL;
+	if (!bOk)
+		return NULL;
+	return PyLong_FromSsize_t(nDeleted);
+}
+
+static PyObject* // new ref
+PxDynaset_set_data_rows(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "column", "value", "rows", NULL };
+	PyObject* pyColumn, *pyData, *pyRows = NULL;
+	Py_ssize_t* pnRows, nCount, n, nColumn;
+	bool bOk = true;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O", kwlist, &pyColumn, &pyData, &pyRows))
+		return NULL;
+	if ((pyColumn = PxDynaset_ColumnArgument(self, pyColumn)) == NULL || (nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+		return NULL;
+	if (PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_EXPR) != Py_None) {
+		PyErr_Format(PyExc_ValueError, "Column '%s' is computed and cannot be edited.", PyUnicode_AsUTF8(PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_NAME)));
+		return NULL;
+	}
+	if ((pnRows = PxDynaset_BatchRows(self, pyRows, &nCount)) == NULL)
+		return NULL;
+
+	// each cell is journaled as if edited by itself, computed cells follow without notice
+	for (n = 0; n < nCount && bOk; n++) {
+		if (!(bOk = PxDynaset_JournalEdit(self, pnRows[n], nColumn, pyData)))
+			break;
+		if (self->nComputed)
+			bOk = PxDynaset_Compute(self, pnRows[n], pyColumn, false);
+	}
+	PyMem_RawFree(pnRows);
+	if (n > 0 && (!PxDynaset_Stain(self) || !PxDynaset_DataChanged(self, -1, pyColumn)))
+		return NULL;
+	if (!bOk)
+		return NULL;
+	return PyLong_FromSsize_t(nCount);
+}
+
+static PyObject* // new ref
+PxDynaset_ClipboardText(PyObject* pyData)
+// text of a cell for a tab separated line, tabs and line breaks in it become spaces
+{
+	static const char* sBreaks[] = { "\t", "\n", "\r" };
+	PyObject* pyText;
+	Py_ssize_t n;
+
+	if (pyData == Py_None)
+		return PyUnicode_New(0, 0);
+	pyText = PyObject_Str(pyData);
+	for (n = 0; n < 3 && pyText; n++)
+		if (PyUnicode_FindChar(pyText, sBreaks[n][0], 0, PY_SSIZE_T_MAX, 1) != -1)
+			Py_SETREF(pyText, PyObject_CallMethod(pyText, "replace", "ss", sBreaks[n], " "));
+	return pyText;
+}
+
+static PyObject* // new ref
+PxDynaset_copy(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "rows", NULL };
+	PyObject* pyRows = NULL, *pyLines = NULL, *pyCells = NULL, *pyData, *pyText = NULL, *pyTab = NULL, *pyNewline = NULL;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t* pnRows, nCount, n;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &pyRows))
+		return NULL;
+	if ((pnRows = PxDynaset_BatchRows(self, pyRows, &nCount)) == NULL)
+		return NULL;
+	if ((pyLines = PyList_New(0)) == NULL || (pyTab = PyUnicode_FromString("\t")) == NULL || (pyNewline = PyUnicode_FromString("\n")) == NULL)
+		goto ERROR;
+
+	// tab separated lines of the columns in the order they have been added, as spreadsheets take them
+	for (n = 0; n < nCount; n++) {
+		if ((pyCells = PyList_New(0)) == NULL)
+			goto ERROR;
+		for (pInfo = self->pColumnInfo; pInfo < self->pColumnInfo + self->nColumnInfo; pInfo++) {
+			if (pInfo->nIndex == -1)
+				continue;
+			if ((pyData = PxDynaset_GetCell(self, pnRows[n], pInfo->nIndex)) == NULL)
+				goto ERROR;
+			pyText = PxDynaset_ClipboardText(pyData);
+			Py_DECREF(pyData);
+			if (pyText == NULL || PyList_Append(pyCells, pyText) == -1)
+				goto ERROR;
+			Py_CLEAR(pyText);
+		}
+		pyText = PyUnicode_Join(pyTab, pyCells);
+		Py_CLEAR(pyCells);
+		if (pyText == NULL || PyList_Append(pyLines, pyText) == -1)
+			goto ERROR;
+		Py_CLEAR(pyText);
+	}
+	if ((pyText = PyUnicode_Join(pyNewline, pyLines)) == NULL)
+		goto ERROR;
+	gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_CLIPBOARD), PyUnicode_AsUTF8(pyText), -1);
+
+ERROR:
+	PyMem_RawFree(pnRows);
+	Py_XDECREF(pyLines);
+	Py_XDECREF(pyCells);
+	Py_XDECREF(pyTab);
+	Py_XDECREF(pyNewline);
+	if (PyErr_Occurred())
+		Py_CLEAR(pyText);
+	return pyText;
+}
+
+// Sequence protocol
+// len(ds), ds[n] and iteration cover the rows loaded in data order, as get_data numbers them, fetching further rows as they are reached.
+// Rows are handed out as lightweight proxies that read and write cells by column name, without parsing arguments for every cell.
+// A proxy holds the row number, once rows are sorted, inserted before it, removed or reloaded it refuses to be used rather than reach another row.
+
+typedef struct _PxDynasetRowProxyObject
+{
+	PyObject_HEAD
+	PxDynasetObject* pyDynaset;
+	Py_ssize_t nRow;      // data row
+	Py_ssize_t nRowGeneration; // of the Dynaset when the proxy was handed out
+}
+PxDynasetRowProxyObject;
+
+typedef struct _PxDynasetIterObject
+{
+	PyObject_HEAD
+	PxDynasetObject* pyDynaset;
+	Py_ssize_t nRow;      // next row to hand out
+	Py_ssize_t nColumn;   // yield the cells of this column, -1 for row proxies
+}
+PxDynasetIterObject;
+
+static int
+PxDynaset_RowReached(PxDynasetObject* self, Py_ssize_t nRow)
+// 1 if the row is loaded, fetching up to it if need be, 0 if the result has no such row, -1 with exception
+{
+	if (nRow >= self->nRows && !self->bFetchComplete && !PxDynaset_FetchTo(self, nRow))
+		return -1;
+	return nRow >= 0 && nRow < self->nRows;
+}
+
+static PyObject* // new ref
+PxDynaset_RowProxy(PxDynasetObject* self, Py_ssize_t nRow)
+{
+	PxDynasetRowProxyObject* pyProxy = PyObject_New(PxDynasetRowProxyObject, &PxDynasetRowProxyType);
+	if (pyProxy == NULL)
+		return NULL;
+	Py_INCREF(self);
+	pyProxy->pyDynaset = self;
+	pyProxy->nRow = nRow;
+	pyProxy->nRowGeneration = self->nRowGeneration;
+	return (PyObject*)pyProxy;
+}
+
+static Py_ssize_t
+PxDynaset_length(PxDynasetObject* self)
+{
+	if (!PxDynaset_FetchAll(self, "count them, see rowsTotal"))
+		return -1;
+	return self->nRows;
+}
+
+static PyObject* // new ref
+PxDynaset_item(PxDynasetObject* self, Py_ssize_t nRow)
+{
+	switch (PxDynaset_RowReached(self, nRow)) {
+	case -1:
+		return NULL;
+	case 0:
+		PyErr_SetString(PyExc_IndexError, "Dynaset row number out of range.");
+		return NULL;
+	}
+	return PxDynaset_RowProxy(self, nRow);
+}
+
+static PyObject* // new ref
+PxDynaset_Iterator(PxDynasetObject* self, Py_ssize_t nColumn)
+{
+	PxDynasetIterObject* pyIter = PyObject_New(PxDynasetIterObject, &PxDynasetIterType);
+	if (pyIter == NULL)
+		return NULL;
+	Py_INCREF(self);
+	pyIter->pyDynaset = self;
+	pyIter->nRow = 0;
+	pyIter->nColumn = nColumn;
+	return (PyObject*)pyIter;
+}
+
+static PyObject* // new ref
+PxDynaset_iter(PxDynasetObject* self)
+{
+	return PxDynaset_Iterator(self, -1);
+}
+
+static PyObject* // new ref
+PxDynaset_iter_column(PxDynasetObject* self, PyObject* args)
+{
+	PyObject* pyColumn;
+	Py_ssize_t nColumn;
+
+	if (!PyArg_ParseTuple(args, "O", &pyColumn))
+		return NULL;
+	if ((pyColumn = PxDynaset_ColumnArgument(self, pyColumn)) == NULL)
+		return NULL;
+	if ((nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+		return NULL;
+	return PxDynaset_Iterator(self, nColumn);
+}
+
+static PyObject* // new ref
+PxDynasetIter_next(PxDynasetIterObject* self)
+{
+	PxDynasetObject* pyDynaset = self->pyDynaset;
+
+	if (pyDynaset == NULL)
+		return NULL;
+	switch (PxDynaset_RowReached(pyDynaset, self->nRow)) {
+	case -1:
+		return NULL;
+	case 0:
+		Py_CLEAR(self->pyDynaset); // exhausted for good
+		return NULL;
+	}
+	if (self->nColumn == -1)
+		return PxDynaset_RowProxy(pyDynaset, self->nRow++);
+	return PxDynaset_GetCell(pyDynaset, self->nRow++, self->nColumn);
+}
+
+static void
+PxDynasetIter_dealloc(PxDynasetIterObject* self)
+{
+	Py_XDECREF(self->pyDynaset);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static bool
+PxDynasetRowProxy_Valid(PxDynasetRowProxyObject* self)
+// the proxy's row still has its number, false with exception if rows have moved since
+{
+	if (self->nRowGeneration != self->pyDynaset->nRowGeneration || self->nRow >= self->pyDynaset->nRows) {
+		PyErr_Format(PyExc_RuntimeError, "Rows of the Dynaset have moved since row %zd was handed out, get it anew.", self->nRow);
+		return false;
+	}
+	return true;
+}
+
+static PyObject* // borrowed ref
+PxDynasetRowProxy_Column(PxDynasetRowProxyObject* self, PyObject* pyKey)
+// the column for a name or DynasetColumn, NULL with exception if the Dynaset has no such column or the row has moved
+{
+	PxDynasetObject* pyDynaset = self->pyDynaset;
+	PyObject* pyColumn;
+
+	if (!PxDynasetRowProxy_Valid(self))
+		return NULL;
+	if (PyUnicode_Check(pyKey)) {
+		if ((pyColumn = PyDict_GetItemWithError(pyDynaset->pyColumns, pyKey)) == NULL && !PyErr_Occurred())
+			PyErr_Format(PyExc_KeyError, "Dynaset has no column named '%U'.", pyKey);
+		return pyColumn;
+	}
+	if (PxDynaset_FindColumn(pyDynaset, pyKey))
+		return pyKey;
+	PyErr_SetString(PyExc_TypeError, "Row items are looked up by column name or DynasetColumn.");
+	return NULL;
+}
+
+static PyObject* // new ref
+PxDynasetRowProxy_subscript(PxDynasetRowProxyObject* self, PyObject* pyKey)
+{
+	PyObject* pyColumn;
+	Py_ssize_t nColumn;
+
+	if ((pyColumn = PxDynasetRowProxy_Column(self, pyKey)) == NULL)
+		return NULL;
+	if ((nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+		return NULL;
+	return PxDynaset_GetCell(self->pyDynaset, self->nRow, nColumn);
+}
+
+static int
+PxDynasetRowProxy_ass_subscript(PxDynasetRowProxyObject* self, PyObject* pyKey, PyObject* pyData)
+{
+	PyObject* pyColumn;
+
+	if (pyData == NULL) {
+		PyErr_SetString(PyExc_TypeError, "Cells cannot be deleted, assign None instead.");
+		return -1;
+	}
+	if ((pyColumn = PxDynasetRowProxy_Column(self, pyKey)) == NULL)
+		return -1;
+	return PxDynaset_SetData(self->pyDynaset, self->nRow, pyColumn, pyData) ? 0 : -1;
+}
+
+static Py_ssize_t
+PxDynasetRowProxy_length(PxDynasetRowProxyObject* self)
+{
+	return PyDict_Size(self->pyDynaset->pyColumns);
+}
+
+static PyObject* // new ref
+PxDynasetRowProxy_data(PxDynasetRowProxyObject* self, PyObject* args)
+{
+	if (!PxDynasetRowProxy_Valid(self))
+		return NULL;
+	return PxDynaset_GetRowDataDict(self->pyDynaset, self->nRow, false);
+}
+
+static PyObject* // new ref
+PxDynasetRowProxy_iter(PxDynasetRowProxyObject* self)
+// the column names, as many as len() counts
+{
+	return PyObject_GetIter(self->pyDynaset->pyColumns);
+}
+
+static PyObject* // new ref
+PxDynasetRowProxy_repr(PxDynasetRowProxyObject* self)
+{
+	return PyUnicode_FromFormat("pylax.Dynaset row %zd of table '%U'", self->nRow, self->pyDynaset->pyTable);
+}
+
+static void
+PxDynasetRowProxy_dealloc(PxDynasetRowProxyObject* self)
+{
+	Py_XDECREF(self->pyDynaset);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyMappingMethods PxDynasetRowProxy_as_mapping = {
+	(lenfunc)PxDynasetRowProxy_length,          /* mp_length */
+	(binaryfunc)PxDynasetRowProxy_subscript,    /* mp_subscript */
+	(objobjargproc)PxDynasetRowProxy_ass_subscript, /* mp_ass_subscript */
+};
+
+static PyMemberDef PxDynasetRowProxy_members[] = {
+	{ "row", T_PYSSIZET, offsetof(PxDynasetRowProxyObject, nRow), READONLY, "Row number in the Dynaset" },
+	{ NULL }
+};
+
+static PyMethodDef PxDynasetRowProxy_methods[] = {
+	{ "data", (PyCFunction)PxDynasetRowProxy_data, METH_NOARGS, "Returns the row's data as dict of column names and values." },
+	{ NULL }
+};
+
+static PyTypeObject PxDynasetRowProxyType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"pylax.DynasetRowProxy",   /* tp_name */
+	sizeof(PxDynasetRowProxyObject), /* tp_basicsize */
+	0,                         /* tp_itemsize */
+	(destructor)PxDynasetRowProxy_dealloc, /* tp_dealloc */
+	0,                         /* tp_print */
+	0,                         /* tp_getattr */
+	0,                         /* tp_setattr */
+	0,                         /* tp_reserved */
+	(reprfunc)PxDynasetRowProxy_repr, /* tp_repr */
+	0,                         /* tp_as_number */
+	0,                         /* tp_as_sequence */
+	&PxDynasetRowProxy_as_mapping, /* tp_as_mapping */
+	0,                         /* tp_hash  */
+	0,                         /* tp_call */
+	0,                         /* tp_str */
+	0,                         /* tp_getattro */
+	0,                         /* tp_setattro */
+	0,                         /* tp_as_buffer */
+	Py_TPFLAGS_DEFAULT,        /* tp_flags */
+	"A row of a Dynaset, row['column'] reads and assigns its cells, iterating yields the column names", /* tp_doc */
+	0,                         /* tp_traverse */
+	0,                         /* tp_clear */
+	0,                         /* tp_richcompare */
+	0,                         /* tp_weaklistoffset */
+	(getiterfunc)PxDynasetRowProxy_iter, /* tp_iter */
+	0,                         /* tp_iternext */
+	PxDynasetRowProxy_methods, /* tp_methods */
+	PxDynasetRowProxy_members, /* tp_members */
+};
+
+static PyTypeObject PxDynasetIterType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"pylax.DynasetIterator",   /* tp_name */
+	sizeof(PxDynasetIterObject), /* tp_basicsize */
+	0,                         /* tp_itemsize */
+	(destructor)PxDynasetIter_dealloc, /* tp_dealloc */
+	0,                         /* tp_print */
+	0,                         /* tp_getattr */
+	0,                         /* tp_setattr */
+	0,                         /* tp_reserved */
+	0,                         /* tp_repr */
+	0,                         /* tp_as_number */
+	0,                         /* tp_as_sequence */
+	0,                         /* tp_as_mapping */
+	0,                         /* tp_hash  */
+	0,                         /* tp_call */
+	0,                         /* tp_str */
+	0,                         /* tp_getattro */
+	0,                         /* tp_setattro */
+	0,                         /* tp_as_buffer */
+	Py_TPFLAGS_DEFAULT,        /* tp_flags */
+	"Iterator over the rows of a Dynaset or the cells of one of its columns", /* tp_doc */
+	0,                         /* tp_traverse */
+	0,                         /* tp_clear */
+	0,                         /* tp_richcompare */
+	0,                         /* tp_weaklistoffset */
+	PyObject_SelfIter,         /* tp_iter */
+	(iternextfunc)PxDynasetIter_next, /* tp_iternext */
+};
+
+// In-memory sorting
+// Keys are extracted once per row and sort column, strings as collation keys, then a permutation of the rows is sorted and applied.
+
+#define PxSORT_NULL    0
+#define PxSORT_INTEGER 1
+#define PxSORT_REAL    2   // ranks with PxSORT_INTEGER
+#define PxSORT_TEXT    3
+#define PxSORT_OBJECT  4   // compared by Python
+
+typedef struct _PxSortKey
+{
+	int iClass;
+	union {
+		long long i;
+		double f;
+		gchar* s;          // from g_utf8_collate_key()
+		PyObject* py;
+	} v;
+}
+PxSortKey;
+
+typedef struct _PxSortContext
+{
+	PxSortKey* pKeys;      // nKeys per row
+	Py_ssize_t nKeys;
+	const bool* pbDescending;
+	bool bError;           // a Python comparison has failed
+}
+PxSortContext;
+
+static bool
+PxDynaset_SortKeyFromObject(PxSortKey* pKey, PyObject* pyData)
+{
+	const char* sText;
+	Py_ssize_t nLength;
+	int iOverflow;
+
+	if (pyData == Py_None)
+		pKey->iClass = PxSORT_NULL;
+	else if (PyLong_Check(pyData)) {
+		pKey->iClass = PxSORT_INTEGER;
+		pKey->v.i = PyLong_AsLongLongAndOverflow(pyData, &iOverflow);
+		if (iOverflow) {
+			pKey->iClass = PxSORT_REAL;
+			pKey->v.f = PyLong_AsDouble(pyData);
+		}
+	}
+	else if (PyFloat_Check(pyData)) {
+		pKey->iClass = PxSORT_REAL;
+		pKey->v.f = PyFloat_AS_DOUBLE(pyData);
+	}
+	else if (PyUnicode_Check(pyData)) {
+		if ((sText = PyUnicode_AsUTF8AndSize(pyData, &nLength)) == NULL)
+			return false;
+		pKey->iClass = PxSORT_TEXT;
+		pKey->v.s = g_utf8_collate_key(sText, nLength);
+	}
+	else {
+		pKey->iClass = PxSORT_OBJECT;
+		Py_INCREF(pyData);
+		pKey->v.py = pyData;
+	}
+	return true;
+}
+
+static bool
+PxDynaset_SortKey(PxDynasetObject* self, Py_ssize_t nRow, Py_ssize_t nColumn, PxSortKey* pKey)
+// columnar data is read in place
+{
+	PxColumnVector* pColumn;
+	PxTextRef* pText;
+	PyObject* pyData;
+	bool bOk;
+
+	if (self->pStore && self->pStore->pColumns[nColumn].iKind != PxCOLUMN_OBJECT) {
+		pColumn = self->pStore->pColumns + nColumn;
+		if (!pColumn->pValid[nRow])
+			pKey->iClass = PxSORT_NULL;
+		else if (pColumn->iKind == PxCOLUMN_INTEGER) {
+			pKey->iClass = PxSORT_INTEGER;
+			pKey->v.i = pColumn->piData[nRow];
+		}
+		else if (pColumn->iKind == PxCOLUMN_REAL) {
+			pKey->iClass = PxSORT_REAL;
+			pKey->v.f = pColumn->pfData[nRow];
+		}
+		else {
+			pText = pColumn->pText + nRow;
+			pKey->iClass = PxSORT_TEXT;
+			pKey->v.s = g_utf8_collate_key(pColumn->sArena + pText->nOffset, (gssize)pText->nLength);
+		}
+		return true;
+	}
+
+	if ((pyData = PxDynaset_GetCell(self, nRow, nColumn)) == NULL)
+		return false;
+	bOk = PxDynaset_SortKeyFromObject(pKey, pyData);
+	Py_DECREF(pyData);
+	return bOk;
+}
+
+static int
+PxDynaset_CompareSortKeys(const PxSortKey* pA, const PxSortKey* pB, bool* pbError)
+{
+	int iClassA = pA->iClass == PxSORT_REAL ? PxSORT_INTEGER : pA->iClass;
+	int iClassB = pB->iClass == PxSORT_REAL ? PxSORT_INTEGER : pB->iClass;
+	double fA, fB;
+	int iResult;
+
+	if (iClassA != iClassB)
+		return iClassA < iClassB ? -1 : 1;
+
+	switch (iClassA) {
+	case PxSORT_INTEGER:
+		if (pA->iClass == PxSORT_INTEGER && pB->iClass == PxSORT_INTEGER)
+			return (pA->v.i > pB->v.i) - (pA->v.i < pB->v.i);
+		fA = pA->iClass == PxSORT_INTEGER ? (double)pA->v.i : pA->v.f;
+		fB = pB->iClass == PxSORT_INTEGER ? (double)pB->v.i : pB->v.f;
+		return (fA > fB) - (fA < fB);
+	case PxSORT_TEXT:
+		return strcmp(pA->v.s, pB->v.s);
+	case PxSORT_OBJECT:
+		if (*pbError)
+			return 0;
+		if ((iResult = PyObject_RichCompareBool(pA->v.py, pB->v.py, Py_LT)) == 1)
+			return -1;
+		if (iResult == 0 && (iResult = PyObject_RichCompareBool(pB->v.py, pA->v.py, Py_LT)) >= 0)
+			return iResult;
+		*pbError = true;
+		return 0;
+	default:
+		return 0;
+	}
+}
+
+static gint
+PxDynaset_CompareRows(gconstpointer pA, gconstpointer pB, gpointer pUserData)
+{
+	PxSortContext* pContext = (PxSortContext*)pUserData;
+	Py_ssize_t nRowA = *(const Py_ssize_t*)pA, nRowB = *(const Py_ssize_t*)pB, n;
+	int iResult;
+
+	for (n = 0; n < pContext->nKeys; n++) {
+		iResult = PxDynaset_CompareSortKeys(pContext->pKeys + nRowA * pContext->nKeys + n, pContext->pKeys + nRowB * pContext->nKeys + n, &pContext->bError);
+		if (iResult != 0)
+			return pContext->pbDescending[n] ? -iResult : iResult;
+	}
+	return (nRowA > nRowB) - (nRowA < nRowB); // equal rows keep their order
+}
+
+static bool
+PxDynaset_PermuteRows(PxDynasetObject* self, const Py_ssize_t* pnOrder)
+// row n becomes the former row pnOrder[n], the row pointer stays on its row
+{
+	PyObject* pyRows, *pyRow;
+	Py_ssize_t n;
+
+	// shown rows stay shown, in their new order
+	if (self->pnVisible && !PxDynaset_PermuteRowList(self->pnVisible, self->nVisible, pnOrder, self->nRows))
+		return false;
+	if (self->nDirty && !PxDynaset_PermuteRowList(self->pnDirty, self->nDirty, pnOrder, self->nRows))
+		return false;
+	if (self->nSelected && !PxDynaset_PermuteRowList(self->pnSelected, self->nSelected, pnOrder, self->nRows))
+		return false;
+	if (!PxDynaset_JournalPermute(self, pnOrder))
+		return false;
+
+	if (self->pStore) {
+		if (!PxColumnStore_Permute(self->pStore, pnOrder))
+			return false;
+	}
+	else {
+		if ((pyRows = PyList_New(self->nRows)) == NULL)
+			return false;
+		for (n = 0; n < self->nRows; n++) {
+			pyRow = PyList_GET_ITEM(self->pyRows, pnOrder[n]);
+			Py_INCREF(pyRow);
+			PyList_SET_ITEM(pyRows, n, pyRow);
+		}
+		Py_DECREF(self->pyRows);
+		self->pyRows = pyRows;
+	}
+	Py_CLEAR(self->pyKeyIndex);
+	self->nRowGeneration++;
+
+	if (self->nRow != -1)
+		for (n = 0; n < self->nRows; n++)
+			if (pnOrder[n] == self->nRow) {
+				self->nRow = n;
+				break;
+			}
+	return true;
+}
+
+bool
+PxDynaset_Sort(PxDynasetObject* self, Py_ssize_t nKeys, PyObject** ppyColumns, const bool* pbDescending)
+// stable sort of all rows by the given DynasetColumns
+{
+	PxSortContext context = { NULL, nKeys, pbDescending, false };
+	Py_ssize_t* pnColumns = NULL, *pnOrder = NULL, nRow, n, nFilled = 0, nSortKeys;
+	bool bOk = false;
+
+	if (self->bPaged) {
+		PyErr_SetString(PyExc_RuntimeError, "A paged Dynaset holds its rows in key order and can not be sorted.");
+		return false;
+	}
+
+	if (!PxDynaset_FetchTo(self, -1))
+		return false;
+
+	pnColumns = (Py_ssize_t*)PyMem_RawMalloc((nKeys ? nKeys : 1) * sizeof(Py_ssize_t));
+	pnOrder = (Py_ssize_t*)PyMem_RawMalloc((self->nRows ? self->nRows : 1) * sizeof(Py_ssize_t));
+	nSortKeys = self->nRows * nKeys;
+	context.pKeys = (PxSortKey*)PyMem_RawCalloc(nSortKeys > 0 ? nSortKeys : 1, sizeof(PxSortKey));
+	if (pnColumns == NULL || pnOrder == NULL || context.pKeys == NULL) {
+		PyErr_NoMemory();
+		goto ERROR;
+	}
+	for (n = 0; n < nKeys; n++)
+		if ((pnColumns[n] = PxDynaset_ColumnIndex(ppyColumns[n])) == -1)
+			goto ERROR;
+
+	for (nRow = 0; nRow < self->nRows; nRow++) {
+		pnOrder[nRow] = nRow;
+		for (n = 0; n < nKeys; n++, nFilled++)
+			if (!PxDynaset_SortKey(self, nRow, pnColumns[n], context.pKeys + nFilled))
+				goto ERROR;
+	}
+
+	g_qsort_with_data(pnOrder, (gint)self->nRows, sizeof(Py_ssize_t), PxDynaset_CompareRows, &context);
+	if (context.bError)
+		goto ERROR;
+
+	if (!PxDynaset_PermuteRows(self, pnOrder))
+		goto ERROR;
+	bOk = PxDynaset_RefreshBoundWidgets(self, false, true, true);
+
+ERROR:
+	for (n = 0; n < nFilled; n++) {
+		if (context.pKeys[n].iClass == PxSORT_TEXT)
+			g_free(context.pKeys[n].v.s);
+		else if (context.pKeys[n].iClass == PxSORT_OBJECT)
+			Py_DECREF(context.pKeys[n].v.py);
+	}
+	PyMem_RawFree(context.pKeys);
+	PyMem_RawFree(pnOrder);
+	PyMem_RawFree(pnColumns);
+	return bOk;
+}
+
+static PyObject* // new ref
+PxDynaset_sort(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "columns", "descending", NULL };
+	PyObject* pyColumns, *pyDescending = Py_False, *pyColumn, *pyResult = NULL;
+	PyObject** ppyColumns = NULL;
+	bool* pbDescending = NULL;
+	Py_ssize_t n, nKeys;
+	int iTrue;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &pyColumns, &pyDescending))
+		return NULL;
+
+	// a single column or a sequence of them
+	if (PyUnicode_Check(pyColumns) || PyObject_TypeCheck(pyColumns, &PxDynasetColumnType))
+		pyColumns = PyTuple_Pack(1, pyColumns);
+	else
+		pyColumns = PySequence_Fast(pyColumns, "Parameter 1 ('columns') must be a column, a column name or a sequence of them.");
+	if (pyColumns == NULL)
+		return NULL;
+	nKeys = PySequence_Fast_GET_SIZE(pyColumns);
+
+	ppyColumns = (PyObject**)PyMem_RawMalloc((nKeys ? nKeys : 1) * sizeof(PyObject*));
+	pbDescending = (bool*)PyMem_RawMalloc((nKeys ? nKeys : 1) * sizeof(bool));
+	if (ppyColumns == NULL || pbDescending == NULL) {
+		PyErr_NoMemory();
+		goto ERROR;
+	}
+
+	for (n = 0; n < nKeys; n++) {
+		pyColumn = PySequence_Fast_GET_ITEM(pyColumns, n);
+		if (PyUnicode_Check(pyColumn)) {
+			if ((ppyColumns[n] = PyDict_GetItem(self->pyColumns, pyColumn)) == NULL) {
+				PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyColumn));
+				goto ERROR;
+			}
+		}
+		else if (PxDynaset_FindColumn(self, pyColumn))
+			ppyColumns[n] = pyColumn;
+		else {
+			PyErr_SetString(PyExc_TypeError, "Parameter 1 ('columns') must contain columns of this Dynaset or their names.");
+			goto ERROR;
+		}
+
+		// either one flag for all columns or one per column
+		if (PyBool_Check(pyDescending) || !PySequence_Check(pyDescending))
+			iTrue = PyObject_IsTrue(pyDescending);
+		else if (PySequence_Size(pyDescending) != nKeys) {
+			PyErr_SetString(PyExc_ValueError, "Parameter 2 ('descending') must have one item per column.");
+			goto ERROR;
+		}
+		else {
+			if ((pyResult = PySequence_GetItem(pyDescending, n)) == NULL)
+				goto ERROR;
+			iTrue = PyObject_IsTrue(pyResult);
+			Py_CLEAR(pyResult);
+		}
+		if (iTrue == -1)
+			goto ERROR;
+		pbDescending[n] = iTrue;
+	}
+
+	if (PxDynaset_Sort(self, nKeys, ppyColumns, pbDescending)) {
+		Py_INCREF(Py_None);
+		pyResult = Py_None;
+	}
+
+ERROR:
+	PyMem_RawFree(ppyColumns);
+	PyMem_RawFree(pbDescending);
+	Py_DECREF(pyColumns);
+	return pyResult;
+}
+
+// Filtering
+// Simple comparisons of a column with a value are evaluated in C, anything else by a Python predicate called with the row data dict.
+
+#define PxFILTER_CONTAINS 6   // next to Py_LT ... Py_GE
+
+typedef struct _PxFilter
+{
+	Py_ssize_t nColumn;
+	int iOp;                // Py_LT ... Py_GE or PxFILTER_CONTAINS
+	PyObject* pyValue;
+	PxSortKey key;          // class and number of pyValue, text is kept in sValue
+	const char* sValue;     // UTF-8 if pyValue is a str
+	Py_ssize_t nValueLength;
+	gchar* sFoldedValue;    // for PxFILTER_CONTAINS
+	PyObject* pyPredicate;  // callable instead of the above, NULL if none
+}
+PxFilter;
+
+static bool
+PxDynaset_FilterResult(int iOp, int iCompare)
+{
+	switch (iOp) {
+	case Py_LT: return iCompare < 0;
+	case Py_LE: return iCompare <= 0;
+	case Py_EQ: return iCompare == 0;
+	case Py_NE: return iCompare != 0;
+	case Py_GT: return iCompare > 0;
+	default: return iCompare >= 0;
+	}
+}
+
+static int
+PxDynaset_FilterRow(PxDynasetObject* self, Py_ssize_t nRow, PxFilter* pFilter)
+// 1 if the row passes, 0 if not, -1 on error
+{
+	PxColumnVector* pColumn;
+	PyObject* pyData = NULL, *pyResult;
+	PxSortKey cell;
+	const char* sText = NULL;
+	Py_ssize_t nLength = 0;
+	gchar* sCopy;
+	int iCompare, iResult = 0;
+
+	if (pFilter->pyPredicate) {
+		if ((pyData = PxDynaset_GetRowDataDict(self, nRow, false)) == NULL)
+			return -1;
+		pyResult = PyObject_CallFunctionObjArgs(pFilter->pyPredicate, pyData, NULL);
+		Py_DECREF(pyData);
+		if (pyResult == NULL)
+			return -1;
+		iResult = PyObject_IsTrue(pyResult);
+		Py_DECREF(pyResult);
+		return iResult;
+	}
+
+	// the cell, columnar data in place
+	cell.iClass = PxSORT_NULL;
+	if (self->pStore && self->pStore->pColumns[pFilter->nColumn].iKind != PxCOLUMN_OBJECT) {
+		pColumn = self->pStore->pColumns + pFilter->nColumn;
+		if (!pColumn->pValid[nRow])
+			cell.iClass = PxSORT_NULL;
+		else if (pColumn->iKind == PxCOLUMN_INTEGER) {
+			cell.iClass = PxSORT_INTEGER;
+			cell.v.i = pColumn->piData[nRow];
+		}
+		else if (pColumn->iKind == PxCOLUMN_REAL) {
+			cell.iClass = PxSORT_REAL;
+			cell.v.f = pColumn->pfData[nRow];
+		}
+		else {
+			cell.iClass = PxSORT_TEXT;
+			sText = pColumn->sArena + pColumn->pText[nRow].nOffset;
+			nLength = (Py_ssize_t)pColumn->pText[nRow].nLength;
+		}
+	}
+	else {
+		if ((pyData = PxDynaset_GetCell(self, nRow, pFilter->nColumn)) == NULL)
+			return -1;
+		if (PyUnicode_Check(pyData)) {
+			cell.iClass = PxSORT_TEXT;
+			if ((sText = PyUnicode_AsUTF8AndSize(pyData, &nLength)) == NULL)
+				goto ERROR;
+		}
+		else if (pyData == Py_None || PyLong_Check(pyData) || PyFloat_Check(pyData))
+			PxDynaset_SortKeyFromObject(&cell, pyData);
+		else
+			cell.iClass = PxSORT_OBJECT;
+	}
+
+	if (cell.iClass == PxSORT_NULL && pFilter->key.iClass == PxSORT_NULL)
+		iResult = (pFilter->iOp == Py_EQ || pFilter->iOp == Py_LE || pFilter->iOp == Py_GE);
+	else if (cell.iClass == PxSORT_NULL || pFilter->key.iClass == PxSORT_NULL)
+		iResult = (pFilter->iOp == Py_NE); // NULL is only unequal to anything else
+	else if (pFilter->iOp == PxFILTER_CONTAINS) {
+		if (cell.iClass == PxSORT_TEXT) {
+			sCopy = g_utf8_casefold(sText, nLength);
+			iResult = strstr(sCopy, pFilter->sFoldedValue) != NULL;
+			g_free(sCopy);
+		}
+	}
+	else if (cell.iClass == PxSORT_OBJECT || pFilter->key.iClass == PxSORT_OBJECT) {
+		if (pyData == NULL && (pyData = PxDynaset_GetCell(self, nRow, pFilter->nColumn)) == NULL)
+			return -1;
+		iResult = PyObject_RichCompareBool(pyData, pFilter->pyValue, pFilter->iOp);
+	}
+	else if (cell.iClass == PxSORT_TEXT && pFilter->key.iClass == PxSORT_TEXT) {
+		if (pFilter->iOp == Py_EQ || pFilter->iOp == Py_NE)
+			iCompare = !(nLength == pFilter->nValueLength && memcmp(sText, pFilter->sValue, nLength) == 0);
+		else {
+			sCopy = g_strndup(sText, nLength); // arena text is not 0 terminated
+			iCompare = g_utf8_collate(sCopy, pFilter->sValue);
+			g_free(sCopy);
+		}
+		iResult = PxDynaset_FilterResult(pFilter->iOp, iCompare);
+	}
+	else // numbers, or values of different kinds ranked as when sorting
+		iResult = PxDynaset_FilterResult(pFilter->iOp, PxDynaset_CompareSortKeys(&cell, &pFilter->key, NULL));
+
+ERROR:
+	Py_XDECREF(pyData);
+	return PyErr_Occurred() ? -1 : iResult;
+}
+
+static bool
+PxDynaset_Filter(PxDynasetObject* self, PxFilter* pFilter)
+// show only the rows passing the filter
+{
+	Py_ssize_t* pnVisible, nVisible = 0, nRow, nCurrent;
+	int iResult;
+
+	if (self->bPaged) {
+		PyErr_SetString(PyExc_RuntimeError, "A paged Dynaset does not hold all rows and can not be filtered.");
+		return false;
+	}
+
+	if (!PxDynaset_FetchTo(self, -1))
+		return false;
+	if ((pnVisible = (Py_ssize_t*)PyMem_RawMalloc((self->nRows ? self->nRows : 1) * sizeof(Py_ssize_t))) == NULL) {
+		PyErr_NoMemory();
+		return false;
+	}
+	for (nRow = 0; nRow < self->nRows; nRow++) {
+		if ((iResult = PxDynaset_FilterRow(self, nRow, pFilter)) == -1) {
+			PyMem_RawFree(pnVisible);
+			return false;
+		}
+		if (iResult)
+			pnVisible[nVisible++] = nRow;
+	}
+	PyMem_RawFree(self->pnVisible);
+	self->pnVisible = pnVisible;
+	self->nVisible = nVisible;
+
+	// keep the row pointer on a row that can be seen
+	nCurrent = self->nRow;
+	if (nCurrent != -1 && PxDynaset_ViewPosition(self, nCurrent) == -1)
+		nCurrent = nVisible ? pnVisible[0] : -1;
+	if (!PxDynaset_RefreshBoundWidgets(self, false, true, false))
+		return false;
+	return PxDynaset_SetRow(self, nCurrent);
+}
+
+static PyObject* // new ref
+PxDynaset_filter(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "predicate", "op", "value", NULL };
+	static const char* sOps[] = { "<", "<=", "==", "!=", ">", ">=", "contains", NULL };
+	PyObject* pyPredicate = Py_None, *pyColumn;
+	const char* sOp = "==";
+	PxFilter filter;
+	bool bOk;
+	int iOp;
+
+	memset(&filter, 0, sizeof(filter));
+	filter.pyValue = Py_None;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OsO", kwlist, &pyPredicate, &sOp, &filter.pyValue))
+		return NULL;
+
+	if (pyPredicate == Py_None) {
+		if (!PxDynaset_ClearFilter(self))
+			return NULL;
+		return PyLong_FromSsize_t(self->nRows);
+	}
+
+	if (PyUnicode_Check(pyPredicate) || PyObject_TypeCheck(pyPredicate, &PxDynasetColumnType)) {
+		if (PyUnicode_Check(pyPredicate)) {
+			if ((pyColumn = PyDict_GetItem(self->pyColumns, pyPredicate)) == NULL)
+				return PyErr_Format(PyExc_AttributeError, "Dynaset has no column named '%s'.", PyUnicode_AsUTF8(pyPredicate));
+		}
+		else if (PxDynaset_FindColumn(self, pyPredicate) == NULL) {
+			PyErr_SetString(PyExc_ValueError, "Parameter 1 ('predicate') must be a column of this Dynaset.");
+			return NULL;
+		}
+		else
+			pyColumn = pyPredicate;
+		if ((filter.nColumn = PxDynaset_ColumnIndex(pyColumn)) == -1)
+			return NULL;
+
+		for (iOp = 0; sOps[iOp] && strcmp(sOps[iOp], sOp) != 0; iOp++)
+			;
+		if (sOps[iOp] == NULL)
+			return PyErr_Format(PyExc_ValueError, "Unknown operator '%s'.", sOp);
+		filter.iOp = iOp;
+
+		if (PyUnicode_Check(filter.pyValue)) {
+			filter.key.iClass = PxSORT_TEXT;
+			if ((filter.sValue = PyUnicode_AsUTF8AndSize(filter.pyValue, &filter.nValueLength)) == NULL)
+				return NULL;
+			if (iOp == PxFILTER_CONTAINS)
+				filter.sFoldedValue = g_utf8_casefold(filter.sValue, filter.nValueLength);
+		}
+		else if (iOp == PxFILTER_CONTAINS) {
+			PyErr_SetString(PyExc_TypeError, "'contains' needs a str value.");
+			return NULL;
+		}
+		else if (filter.pyValue == Py_None || PyLong_Check(filter.pyValue) || PyFloat_Check(filter.pyValue))
+			PxDynaset_SortKeyFromObject(&filter.key, filter.pyValue);
+		else
+			filter.key.iClass = PxSORT_OBJECT;
+	}
+	else if (PyCallable_Check(pyPredicate))
+		filter.pyPredicate = pyPredicate;
+	else {
+		PyErr_SetString(PyExc_TypeError, "Parameter 1 ('predicate') must be a callable, a column or a column name.");
+		return NULL;
+	}
+
+	bOk = PxDynaset_Filter(self, &filter);
+	g_free(filter.sFoldedValue);
+	if (!bOk)
+		return NULL;
+	return PyLong_FromSsize_t(self->nVisible);
+}
+
+static bool
+PxDynaset_ClearFilter(PxDynasetObject* self)
+// show all rows again
+{
+	if (self->pnVisible == NULL)
+		return true;
+	PxDynaset_DropFilter(self);
+	if (!PxDynaset_RefreshBoundWidgets(self, false, true, false))
+		return false;
+	return true;
+}
+
+static PyObject* // new ref
+PxDynaset_clear_filter(PxDynasetObject* self, PyObject* args)
+{
+	if (!PxDynaset_ClearFilter(self))
+		return NULL;
+	Py_RETURN_NONE;
+}
+
+bool
+PxDynaset_Clear(PxDynasetObject* self)
+{
+	if (!PxDynaset_CloseCursor(self))
+		return false;
+	PxDynaset_DropFilter(self);
+	PxDynaset_DropDirty(self);
+	PxDynaset_DropSelection(self);
+	PxDynaset_ForgetJournal(self);
+	Py_CLEAR(self->pyCacheKey);
+	Py_CLEAR(self->pyKeyIndex);
+	self->nRowGeneration++;
+
+	if (self->nRows == 0)
+		return true;
+
+	else if (!PxDynaset_SetRow(self, -1))
+		return false;
+
+	Py_DECREF(self->pyRows);
+	self->pyRows = PyList_New(0);
+	PxColumnStore_Free(self->pStore);
+	self->pStore = NULL;
+	self->nRows = 0;
+	self->nRow = -1;
+	Py_XDECREF(self->pyEmptyRowData);
+	self->pyEmptyRowData = NULL;
+
+	// refresh bound table widgets
+	if (!PxDynaset_RefreshBoundWidgets(self, false, true, false))
+		return false;
+	return true;
+}
+
+static PyObject* // new ref
+PxDynaset_clear(PxDynasetObject* self, PyObject* args)
+{
+	if (!PxDynaset_Clear(self))
+		return NULL;
+	Py_RETURN_NONE;
+}
+
+static void
+PxDynaset_UnmapColumns(PxDynasetObject* self)
+// a new query result is coming, columns it does not contain end up without index
+{
+	Py_ssize_t n;
+	for (n = 0; n < self->nColumnInfo; n++)
+		if (self->pColumnInfo[n].nIndex != -1)
+			PxDynaset_SetColumnIndex(self->pColumnInfo + n, -1);
+	self->nDataColumns = 0;
+	Py_CLEAR(self->pyEmptyRowData);
+	Py_CLEAR(self->pyKeyIndex);
+	PxDynaset_ForgetStatements(self);
+}
+
+static bool
+PxDynaset_MapColumn(PxDynasetObject* self, PyObject* pyColumnName, Py_ssize_t nIndex)
+// make my column's index number point to correct position in query result tuples
+{
+	PyObject* pyColumn;
+
+	pyColumn = PyDict_GetItem(self->pyColumns, pyColumnName);
+	if (pyColumn == NULL) {
+		PyErr_Format(PyExc_AttributeError, "Column '%s' of query not contained in Dynaset's column list.", PyUnicode_AsUTF8(pyColumnName));
+		return false;
+	}
+	PxDynaset_SetColumnIndex(PxDynaset_FindColumn(self, pyColumn), nIndex);
+	self->nDataColumns = nIndex + 1;
+	return true;
+}
+
+static bool
+PxDynaset_Executed(PxDynasetObject* self)
+// a new result has been loaded
+{
+	PyObject* pyResult;
+
+	// notify table widgets
+	if (!PxDynaset_RefreshBoundWidgets(self, false, true, false))
+		return false;
+
+	if (self->pyOnChangedCB) {
+		PyObject* pyArgs = Py_BuildValue("(OiO)", (PyObject*)self, -1,Py_None);
+		pyResult = PyObject_CallObject(self->pyOnChangedCB, pyArgs);
+		Py_XDECREF(pyArgs);
+		if (pyResult == NULL)
+			return false;
+		else {
+			Py_XDECREF(pyResult);
+		}
+	}
+	return true;
+}
+
+static void
+PxDynaset_SetLoading(PxDynasetObject* self, bool bLoading)
+// grey out bound tables while a query is running in the background
+{
+	PxWidgetObject* pyWidget;
+	Py_ssize_t n, nLen;
+
+	self->bLoading = bLoading;
+	nLen = PySequence_Size(self->pyWidgets);
+	for (n = 0; n < nLen; n++) {
+		pyWidget = (PxWidgetObject*)PyList_GetItem(self->pyWidgets, n);
+		if (pyWidget->bTable)
+			gtk_widget_set_sensitive(pyWidget->gtk, !bLoading);
+	}
+}
+
+static PyObject* // new ref
+PxDynaset_DatabaseFile(PxDynasetObject* self)
+// file name of the main database of the connection, empty string if in memory
+{
+	PyObject* pyCursor, *pyRows, *pyRow, *pyFile = NULL;
+	Py_ssize_t n;
+
+	if ((pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(s)", "PRAGMA database_list;")) == NULL)
+		return NULL;
+	pyRows = PyObject_CallMethod(pyCursor, "fetchall", NULL);
+	Py_DECREF(pyCursor);
+	if (pyRows == NULL)
+		return NULL;
+
+	for (n = 0; n < PyList_GET_SIZE(pyRows); n++) {
+		pyRow = PyList_GET_ITEM(pyRows, n);
+		if (PyUnicode_CompareWithASCIIString(PyTuple_GET_ITEM(pyRow, 1), "main") == 0) {
+			pyFile = PyTuple_GET_ITEM(pyRow, 2);
+			Py_INCREF(pyFile);
+			break;
+		}
+	}
+	Py_DECREF(pyRows);
+	if (pyFile == NULL)
+		pyFile = PyUnicode_FromString("");
+	return pyFile;
+}
+
+static bool
+PxDynaset_LoadQuery(PxDynasetObject* self, PxQuery* pQuery)
+// take over the rows a worker thread has read
+{
+	PyObject* pyColumnName, *pyRowData, *pyError;
+	Py_ssize_t nRow;
+	int nColumn;
+	bool bOk;
+
+	if (pQuery->iResult != SQLITE_DONE) {
+		if ((pyError = PyObject_GetAttrString(g.pySQLiteModule, "OperationalError")) == NULL)
+			return false;
+		PyErr_SetString(pyError, pQuery->sError ? pQuery->sError : "Query failed.");
+		Py_DECREF(pyError);
+		return false;
+	}
+
+	PxDynaset_UnmapColumns(self);
+	for (nColumn = 0; nColumn < pQuery->nColumns; nColumn++) {
+		if ((pyColumnName = PxQuery_GetColumnName(pQuery, nColumn)) == NULL)
+			return false;
+		bOk = PxDynaset_MapColumn(self, pyColumnName, nColumn);
+		Py_DECREF(pyColumnName);
+		if (!bOk)
+			return false;
+	}
+	PxDynaset_MapComputedColumns(self);
+
+	if (self->bColumnar && !PxDynaset_CreateStore(self, self->nDataColumns))
+		return false;
+
+	self->nRows = 0;
+	for (nRow = 0; nRow < pQuery->nRows; nRow++) {
+		if ((pyRowData = PxQuery_GetRow(pQuery, nRow)) == NULL)
+			return false;
+		bOk = PxDynaset_InsertRow(self, self->nRows, pyRowData, 0);
+		Py_DECREF(pyRowData);
+		if (!bOk)
+			return false;
+	}
+	self->bFetchComplete = true;
+
+	return PxDynaset_Executed(self);
+}
+
+static gboolean
+PxDynaset_QueryDoneCB(gpointer gUserData)
+{
+	PxQuery* pQuery = (PxQuery*)gUserData;
+	PxDynasetObject* self = (PxDynasetObject*)pQuery->pUserData;
+
+	if (self->pQuery == pQuery) { // not superseded
+		self->pQuery = NULL;
+		PxDynaset_SetLoading(self, false);
+		if (!PxDynaset_LoadQuery(self, pQuery))
+			PythonErrorDialog();
+	}
+	PxQuery_Free(pQuery);
+	Py_DECREF(self);
+	return G_SOURCE_REMOVE;
+}
+
+static bool
+PxDynaset_StartQuery(PxDynasetObject* self, const char* sDatabase, PyObject* pyParameters)
+{
+	PxQuery* pQuery;
+
+	if ((pQuery = PxQuery_New(sDatabase, self->pyQuery, pyParameters)) == NULL)
+		return false;
+	if (!PxQuery_Start(pQuery, PxDynaset_QueryDoneCB, self)) {
+		PxQuery_Free(pQuery);
+		return false;
+	}
+	Py_INCREF(self); // released by the done callback
+	self->pQuery = pQuery;
+	PxDynaset_SetLoading(self, true);
+	return true;
+}
+
+// Keyset paging
+// A paged Dynaset holds a window of at most nPagesKept pages of nFetchSize rows in key order. Pages next to the window are read with
+// WHERE (keys) > (last key) ORDER BY keys LIMIT nFetchSize, which costs the same anywhere in the table, and pages far from the row pointer are dropped.
+
+static PyObject* // new ref
+PxDynaset_InnerQuery(PxDynasetObject* self)
+// the query without the trailing ';', which would end the statement it is wrapped in
+{
+	const char* sQuery;
+	Py_ssize_t nLength;
+
+	if ((sQuery = PyUnicode_AsUTF8AndSize(self->pyQuery, &nLength)) == NULL)
+		return NULL;
+	while (nLength > 0 && (g_ascii_isspace(sQuery[nLength - 1]) || sQuery[nLength - 1] == ';'))
+		nLength--;
+	return PyUnicode_FromStringAndSize(sQuery, nLength);
+}
+
+static PyObject* // new ref
+PxDynaset_PageQuery(PxDynasetObject* self, int iDirection)
+// the query limited to the first page (0) or to the page after (1) or before (-1) the key values given as :_px0, :_px1...
+{
+	PyObject* pyParts, *pyText, *pyEmpty, *pySQL = NULL;
+	PxDynasetColumnInfo* pInfo;
+	char sText[40];
+	Py_ssize_t n, nKeys = 0;
+	int iResult = 0;
+
+	if ((pyParts = PyList_New(0)) == NULL)
+		return NULL;
+	if ((pyText = PxDynaset_InnerQuery(self)) == NULL)
+		goto ERROR;
+	iResult |= PxListAppendString(pyParts, "SELECT * FROM (");
+	iResult |= PyList_Append(pyParts, pyText);
+	iResult |= PxListAppendString(pyParts, ")");
+	Py_DECREF(pyText);
+
+	if (iDirection != 0) {
+		iResult |= PxListAppendString(pyParts, " WHERE (");
+		for (n = 0; n < self->nColumnInfo; n++) {
+			pInfo = self->pColumnInfo + n;
+			if (pInfo->iKey != 1)
+				continue;
+			if (nKeys++ > 0)
+				iResult |= PxListAppendString(pyParts, ",");
+			iResult |= PyList_Append(pyParts, PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_NAME));
+		}
+		iResult |= PxListAppendString(pyParts, iDirection > 0 ? ") > (" : ") < (");
+		for (n = 0; n < nKeys; n++) {
+			sprintf(sText, n ? ",:_px%zd" : ":_px%zd", n);
+			iResult |= PxListAppendString(pyParts, sText);
+		}
+		iResult |= PxListAppendString(pyParts, ")");
+		nKeys = 0;
+	}
+
+	iResult |= PxListAppendString(pyParts, " ORDER BY ");
+	for (n = 0; n < self->nColumnInfo; n++) {
+		pInfo = self->pColumnInfo + n;
+		if (pInfo->iKey != 1)
+			continue;
+		if (nKeys++ > 0)
+			iResult |= PxListAppendString(pyParts, ",");
+		iResult |= PyList_Append(pyParts, PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_NAME));
+		if (iDirection < 0)
+			iResult |= PxListAppendString(pyParts, " DESC");
+	}
+	if (nKeys == 0) {
+		PyErr_SetString(PyExc_RuntimeError, "A paged Dynaset needs key columns.");
+		goto ERROR;
+	}
+	sprintf(sText, " LIMIT %zd;", self->nFetchSize);
+	iResult |= PxListAppendString(pyParts, sText);
+	if (iResult != 0)
+		goto ERROR;
+
+	if ((pyEmpty = PyUnicode_New(0, 0)) == NULL)
+		goto ERROR;
+	pySQL = PyUnicode_Join(pyEmpty, pyParts);
+	Py_DECREF(pyEmpty);
+
+ERROR:
+	Py_DECREF(pyParts);
+	return pySQL;
+}
+
+static PyObject* // new ref
+PxDynaset_PageParameters(PxDynasetObject* self, Py_ssize_t nRow)
+// the query's parameters extended by the key values of row nRow
+{
+	PyObject* pyParams, *pyName, *pyData;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t n, nKey = 0;
+	int iResult;
+
+	if ((pyParams = self->pyParameters ? PyDict_Copy(self->pyParameters) : PyDict_New()) == NULL)
+		return NULL;
+	for (n = 0; n < self->nColumnInfo; n++) {
+		pInfo = self->pColumnInfo + n;
+		if (pInfo->iKey != 1)
+			continue;
+		if (pInfo->nIndex == -1) {
+			PxDynaset_ColumnIndex(pInfo->pyColumn); // sets the exception
+			goto ERROR;
+		}
+		if ((pyData = PxDynaset_GetCell(self, nRow, pInfo->nIndex)) == NULL)
+			goto ERROR;
+		if ((pyName = PyUnicode_FromFormat("_px%zd", nKey++)) == NULL) {
+			Py_DECREF(pyData);
+			goto ERROR;
+		}
+		iResult = PyDict_SetItem(pyParams, pyName, pyData);
+		Py_DECREF(pyName);
+		Py_DECREF(pyData);
+		if (iResult == -1)
+			goto ERROR;
+	}
+	return pyParams;
+
+ERROR:
+	Py_DECREF(pyParams);
+	return NULL;
+}
+
+static Py_ssize_t
+PxDynaset_CountRows(PxDynasetObject* self, PyObject* pyParameters)
+// rows of the whole result, -1 on error
+{
+	PyObject* pyInner, *pyCursor, *pyRow;
+	Py_ssize_t nRows = -1;
+
+	if ((pyInner = PxDynaset_InnerQuery(self)) == NULL)
+		return -1;
+	if (pyParameters)
+		pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(NO)", PyUnicode_FromFormat("SELECT count(*) FROM (%U);", pyInner), pyParameters);
+	else
+		pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(N)", PyUnicode_FromFormat("SELECT count(*) FROM (%U);", pyInner));
+	Py_DECREF(pyInner);
+	if (pyCursor == NULL)
+		return -1;
+	pyRow = PyObject_CallMethod(pyCursor, "fetchone", NULL);
+	Py_DECREF(pyCursor);
+	if (pyRow == NULL)
+		return -1;
+	nRows = PyLong_AsSsize_t(PyTuple_GET_ITEM(pyRow, 0));
+	Py_DECREF(pyRow);
+	return nRows;
+}
+
+static bool
+PxDynaset_RowsShifted(PxDynasetObject* self, Py_ssize_t nFirst, Py_ssize_t nDelta)
+// nDelta rows have been inserted before row nFirst or, if negative, rows from nFirst on removed, let tables follow without losing their place
+{
+	PxWidgetObject* pyDependent;
+	PyObject* pyResult;
+	Py_ssize_t n, nLen;
+
+	nLen = PySequence_Size(self->pyWidgets);
+	for (n = 0; n < nLen; n++) {
+		pyDependent = (PxWidgetObject*)PyList_GetItem(self->pyWidgets, n);
+		if (pyDependent->bTable) {
+			if ((pyResult = PyObject_CallMethod((PyObject*)pyDependent, nDelta > 0 ? "insert_rows" : "remove_rows", "nn", nFirst, nDelta > 0 ? nDelta : -nDelta)) == NULL)
+				return false;
+			Py_DECREF(pyResult);
+		}
+	}
+	return true;
+}
+
+static Py_ssize_t
+PxDynaset_FetchPage(PxDynasetObject* self, int iDirection)
+// read the page after (1) or before (-1) the loaded rows, returns the number of rows added or -1
+{
+	PyObject* pySQL = NULL, *pyParams = NULL, *pyCursor, *pyRows = NULL;
+	Py_ssize_t n, nRow = 0, nAdded = -1;
+
+	// the key of the outermost row that is in the database
+	for (n = 0; n < self->nRows; n++) {
+		nRow = iDirection > 0 ? self->nRows - 1 - n : n;
+		if (!(PxDynaset_GetRowState(self, nRow) & PxROW_NEW))
+			break;
+	}
+	if (n == self->nRows) {
+		if (iDirection < 0) {
+			self->bPageStart = true;
+			return 0;
+		}
+		iDirection = 0; // nothing loaded, start over
+	}
+
+	if ((pySQL = PxDynaset_PageQuery(self, iDirection)) == NULL)
+		goto ERROR;
+	if (iDirection == 0)
+		pyParams = self->pyParameters ? PyDict_Copy(self->pyParameters) : PyDict_New();
+	else
+		pyParams = PxDynaset_PageParameters(self, nRow);
+	if (pyParams == NULL)
+		goto ERROR;
+	if ((pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(OO)", pySQL, pyParams)) == NULL)
+		goto ERROR;
+	pyRows = PyObject_CallMethod(pyCursor, "fetchall", NULL);
+	Py_DECREF(pyCursor);
+	if (pyRows == NULL)
+		goto ERROR;
+
+	// a page before the window arrives in descending order, each row goes in front of the previous one
+	for (n = 0; n < PyList_GET_SIZE(pyRows); n++)
+		if (!PxDynaset_InsertRow(self, iDirection < 0 ? 0 : self->nRows, PyList_GET_ITEM(pyRows, n), 0))
+			goto ERROR;
+	nAdded = PyList_GET_SIZE(pyRows);
+
+	if (iDirection < 0) {
+		if (self->nRow != -1)
+			self->nRow += nAdded;
+		self->nRowOffset = self->nRowOffset > nAdded ? self->nRowOffset - nAdded : 0;
+		if (nAdded < self->nFetchSize) {
+			self->bPageStart = true;
+			self->nRowOffset = 0;
+		}
+	}
+	else if (nAdded < self->nFetchSize)
+		self->bFetchComplete = true;
+
+ERROR:
+	Py_XDECREF(pySQL);
+	Py_XDECREF(pyParams);
+	Py_XDECREF(pyRows);
+	return nAdded;
+}
+
+static bool
+PxDynaset_TrimPages(PxDynasetObject* self, bool bFront)
+// drop rows at the front or the end beyond nPagesKept pages, the current row and changed rows are kept with everything between them and the other end
+{
+	Py_ssize_t* pnRows, n, nCount = self->nRows - self->nFetchSize * (self->nPagesKept > 0 ? self->nPagesKept : 1);
+
+	if (nCount <= 0)
+		return true;
+	PxDynaset_HasDirtyRows(self); // prunes pnDirty
+	if (bFront) {
+		if (self->nRow != -1 && self->nRow < nCount)
+			nCount = self->nRow;
+		if (self->nDirty && self->pnDirty[0] < nCount)
+			nCount = self->pnDirty[0];
+	}
+	else {
+		if (self->nRow != -1 && self->nRows - 1 - self->nRow < nCount)
+			nCount = self->nRows - 1 - self->nRow;
+		if (self->nDirty && self->nRows - 1 - self->pnDirty[self->nDirty - 1] < nCount)
+			nCount = self->nRows - 1 - self->pnDirty[self->nDirty - 1];
+	}
+	if (nCount <= 0)
+		return true;
+
+	if ((pnRows = (Py_ssize_t*)PyMem_RawMalloc(nCount * sizeof(Py_ssize_t))) == NULL) {
+		PyErr_NoMemory();
+		return false;
+	}
+	for (n = 0; n < nCount; n++)
+		pnRows[n] = bFront ? n : self->nRows - nCount + n;
+	if (!PxDynaset_RemoveRows(self, pnRows, nCount)) {
+		PyMem_RawFree(pnRows);
+		return false;
+	}
+	PyMem_RawFree(pnRows);
+
+	if (bFront) {
+		if (self->nRow != -1)
+			self->nRow -= nCount;
+		self->nRowOffset += nCount;
+		self->bPageStart = false;
+		return PxDynaset_RowsShifted(self, 0, -nCount);
+	}
+	self->bFetchComplete = false;
+	return PxDynaset_RowsShifted(self, self->nRows, -nCount);
+}
+
+static gboolean
+PxDynaset_PreviousPageIdleCB(gpointer gUserData)
+{
+	PxDynasetObject* self = (PxDynasetObject*)gUserData;
+	Py_ssize_t nAdded;
+
+	self->iPageSourceID = 0;
+	if ((nAdded = PxDynaset_FetchPage(self, -1)) == -1 ||
+		(nAdded > 0 && (!PxDynaset_RowsShifted(self, 0, nAdded) || !PxDynaset_TrimPages(self, false))))
+		PythonErrorDialog();
+	Py_DECREF(self);
+	return G_SOURCE_REMOVE;
+}
+
+void
+PxDynaset_RequestPreviousPage(PxDynasetObject* self)
+// read the page before the window from the main loop, the counterpart of PxDynaset_RequestFetch for a paged Dynaset scrolled up
+{
+	if (!self->bPaged || self->bPageStart || self->iPageSourceID || self->bLoading)
+		return;
+	Py_INCREF(self); // released by the idle callback
+	self->iPageSourceID = g_idle_add(PxDynaset_PreviousPageIdleCB, self);
+}
+
+// Child result cache
+// A child Dynaset with cacheSize set keeps the rows it has loaded for recently visited parent rows.
+// Results are only kept while nothing has been written to the database, neither through this connection nor any other.
+
+static bool
+PxDynaset_CacheStamp(PxDynasetObject* self, long long* piChanges, long long* piVersion)
+{
+	PyObject* pyChanges, *pyCursor, *pyRow;
+
+	if ((pyChanges = PyObject_GetAttrString(self->pyConnection, "total_changes")) == NULL)
+		return false;
+	*piChanges = PyLong_AsLongLong(pyChanges);
+	Py_DECREF(pyChanges);
+
+	if ((pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(s)", "PRAGMA data_version;")) == NULL)
+		return false;
+	pyRow = PyObject_CallMethod(pyCursor, "fetchone", NULL);
+	Py_DECREF(pyCursor);
+	if (pyRow == NULL)
+		return false;
+	*piVersion = PyLong_AsLongLong(PyTuple_GET_ITEM(pyRow, 0));
+	Py_DECREF(pyRow);
+	return !PyErr_Occurred();
+}
+
+static void
+PxDynaset_DropCache(PxDynasetObject* self)
+{
+	Py_CLEAR(self->pyCache);
+	Py_CLEAR(self->pyCacheKey);
+}
+
+static int
+PxDynaset_ValidateCache(PxDynasetObject* self)
+// 1 if nothing has been written since the cached results were loaded, 0 if they have been dropped, -1 on error
+{
+	long long iChanges, iVersion;
+
+	if (!PxDynaset_CacheStamp(self, &iChanges, &iVersion))
+		return -1;
+	if (iChanges == self->iCacheChanges && iVersion == self->iCacheVersion)
+		return 1;
+	if (self->pyCache)
+		PyDict_Clear(self->pyCache);
+	self->iCacheChanges = iChanges;
+	self->iCacheVersion = iVersion;
+	return 0;
+}
+
+static bool
+PxDynaset_CacheRows(PxDynasetObject* self)
+// keep the current rows before they get replaced, if they are complete and unchanged
+{
+	PyObject* pyEntry, *pyRowData, *pyKey;
+	Py_ssize_t nRow, nPosition = 0;
+	int iResult;
+
+	if (self->pyCacheKey == NULL || self->nCacheSize <= 0 || self->bPaged || !self->bFetchComplete || self->pQuery || PxDynaset_HasDirtyRows(self))
+		return true;
+	if ((iResult = PxDynaset_ValidateCache(self)) != 1) // the rows may be outdated
+		return iResult == 0;
+	if (self->pyCache == NULL && (self->pyCache = PyDict_New()) == NULL)
+		return false;
+
+	if ((pyEntry = PyTuple_New(self->nRows)) == NULL)
+		return false;
+	for (nRow = 0; nRow < self->nRows; nRow++) {
+		if ((pyRowData = PxDynaset_GetRowTuple(self, nRow)) == NULL) {
+			Py_DECREF(pyEntry);
+			return false;
+		}
+		PyTuple_SET_ITEM(pyEntry, nRow, pyRowData);
+	}
+	iResult = PyDict_SetItem(self->pyCache, self->pyCacheKey, pyEntry);
+	Py_DECREF(pyEntry);
+	if (iResult == -1)
+		return false;
+
+	// evict the least recently used
+	while (PyDict_GET_SIZE(self->pyCache) > self->nCacheSize) {
+		nPosition = 0;
+		PyDict_Next(self->pyCache, &nPosition, &pyKey, NULL);
+		if (PyDict_DelItem(self->pyCache, pyKey) == -1)
+			return false;
+	}
+	return true;
+}
+
+static int
+PxDynaset_RestoreRows(PxDynasetObject* self, PyObject* pyKey)
+// load the rows kept for the parent values pyKey, 1 if found, 0 if not, -1 on error
+{
+	PyObject* pyEntry;
+	Py_ssize_t nRow;
+	int iValid;
+
+	// also takes the stamp the rows about to be queried will be valid for
+	if ((iValid = PxDynaset_ValidateCache(self)) != 1 || self->pyCache == NULL)
+		return iValid == -1 ? -1 : 0;
+	if ((pyEntry = PyDict_GetItemWithError(self->pyCache, pyKey)) == NULL)
+		return PyErr_Occurred() ? -1 : 0;
+
+	// taken out of the cache while in use, put back at the end when the parent moves on
+	Py_INCREF(pyEntry);
+	if (PyDict_DelItem(self->pyCache, pyKey) == -1)
+		goto ERROR;
+	if (self->bColumnar && !PxDynaset_CreateStore(self, self->nDataColumns))
+		goto ERROR;
+	for (nRow = 0; nRow < PyTuple_GET_SIZE(pyEntry); nRow++)
+		if (!PxDynaset_InsertRow(self, self->nRows, PyTuple_GET_ITEM(pyEntry, nRow), 0))
+			goto ERROR;
+	Py_DECREF(pyEntry);
+	self->bFetchComplete = true;
+	return 1;
+
+ERROR:
+	Py_DECREF(pyEntry);
+	return -1;
+}
+
+static PyObject* // new ref
+PxDynaset_ExecuteDirect(PxDynasetObject* self, PyObject* pyPageQuery, PyObject* pyParameters)
+// the rest of execute with the statement prepared on the connection's handle
+{
+	PyObject* pyColumnName;
+	sqlite3* pDb;
+	int nColumn;
+	bool bOk;
+
+	if ((pDb = PxQuery_Handle(self->pyConnection)) == NULL ||
+		(self->pStatement = PxQuery_Prepare(pDb, pyPageQuery ? pyPageQuery : self->pyQuery, pyParameters ? pyParameters : Py_None)) == NULL)
+		return NULL;
+
+	PxDynaset_UnmapColumns(self);
+	for (nColumn = 0; nColumn < self->pStatement->nColumns; nColumn++) {
+		if ((pyColumnName = PxQuery_GetColumnName(self->pStatement, nColumn)) == NULL)
+			return NULL;
+		bOk = PxDynaset_MapColumn(self, pyColumnName, nColumn);
+		Py_DECREF(pyColumnName);
+		if (!bOk)
+			return NULL;
+	}
+	PxDynaset_MapComputedColumns(self);
+
+	if (self->bColumnar && !PxDynaset_CreateStore(self, self->nDataColumns))
+		return NULL;
+
+	self->nRows = 0;
+	self->bFetchComplete = false;
+	if (PxDynaset_Fetch(self, self->nFetchSize > 0 ? self->nFetchSize : -1) == -1)
+		return NULL;
+	if (!PxDynaset_Executed(self))
+		return NULL;
+	return PyLong_FromSsize_t(self->nRows);
+}
+
+PyObject* // new ref
+PxDynaset_execute(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "parameters", "query", "async_", NULL };
+	PyObject* pyParameters = NULL, *pyQuery = NULL, *pyResult = NULL, *pyDatabase, *pyKey = NULL, *pyPageQuery = NULL, *pyInTransaction;
+	PyObject* pyParentDynasetColumn, *pyParentDynasetColumnName, *pyData, *pyColumnDescriptions = NULL, *pyIterator = NULL, *pyItem, *pyColumnName;
+	Py_ssize_t n, nIndex = 0;
+	int bAsync = false, iCached, iInTransaction;
+	bool bOk;
+	if (args && !PyArg_ParseTupleAndKeywords(args, kwds, "|OOp", kwlist, &pyParameters, &pyQuery, &bAsync)) {
+		return NULL;
+	}
+	if (pyParameters) {
+		if (!PyDict_Check(pyParameters)) {
+			PyErr_SetString(PyExc_TypeError, "Parameter 1 ('parameters') must be a dict.");
+			return NULL;
+		}
+		Py_INCREF(pyParameters); // let go of on the way out, as those taken from the parent
+	}
+	else if (self->pyParent) {
+		if ((pyParameters = PyDict_New()) == NULL)
+			return NULL;
+		if (self->nCacheSize > 0 && pyQuery == NULL && (pyKey = PyList_New(0)) == NULL)
+			goto EXIT;
+
+		for (n = 0; n < self->nColumnInfo; n++) {
+			pyParentDynasetColumn = self->pColumnInfo[n].pyParentColumn;
+			if (pyParentDynasetColumn) {
+				pyData = PxDynaset_GetData(self->pyParent, self->pyParent->nRow, pyParentDynasetColumn);
+				pyParentDynasetColumnName = PyStructSequence_GET_ITEM(pyParentDynasetColumn, PXDYNASETCOLUMN_NAME);
+				if (pyData == NULL)
+					goto EXIT;
+				bOk = PyDict_SetItem(pyParameters, pyParentDynasetColumnName /*pyColumnName*/, pyData) != -1 &&
+					(pyKey == NULL || PyList_Append(pyKey, pyData) != -1);
+				Py_DECREF(pyData);
+				if (!bOk)
+					goto EXIT;
+			}
+		}
+
+		if (PyDict_Size(pyParameters) == 0) {
+			Py_CLEAR(pyParameters);
+			Py_CLEAR(pyKey);
+		}
+		else if (pyKey) {
+			Py_SETREF(pyKey, PyList_AsTuple(pyKey));
+			if (pyKey == NULL)
+				goto EXIT;
+		}
+	}
+	if (self->nCacheSize <= 0 && self->pyCache)
+		PxDynaset_DropCache(self);
+
+	if (pyQuery) {
+		if (PyUnicode_Check(pyQuery)) {
+			PxDynaset_DropCache(self); // results of another query
+			PxAttachObject(&self->pyQuery, pyQuery, true);
+		}
+		else {
+			PyErr_SetString(PyExc_TypeError, "Parameter 2 ('query') must be a string.");
+			goto EXIT;
+		}
+	}
+
+	if (!PxDynaset_CacheRows(self) || !PxDynaset_Clear(self) || !PxDynaset_WatchStamp(self)) // closes the previous cursor as well
+		goto EXIT;
+	Py_CLEAR(self->pyParameters);
+	if (pyParameters && (self->pyParameters = PyDict_Copy(pyParameters)) == NULL)
+		goto EXIT;
+
+	if (pyKey) {
+		self->pyCacheKey = pyKey;
+		pyKey = NULL;
+		if ((iCached = PxDynaset_RestoreRows(self, self->pyCacheKey)) == -1)
+			goto EXIT;
+		if (iCached) {
+			if (PxDynaset_Executed(self))
+				pyResult = PyLong_FromSsize_t(self->nRows);
+			goto EXIT;
+		}
+	}
+
+	// a paged Dynaset reads the first page now and the others by key when they are needed
+	if (self->bPaged) {
+		if (self->nFetchSize <= 0) {
+			PyErr_SetString(PyExc_ValueError, "A paged Dynaset needs a fetchSize.");
+			goto EXIT;
+		}
+		bAsync = false;
+		self->bPageStart = true;
+		self->nRowOffset = 0;
+		if ((self->nRowsTotal = PxDynaset_CountRows(self, pyParameters)) == -1)
+			goto EXIT;
+		if ((pyPageQuery = PxDynaset_PageQuery(self, 0)) == NULL)
+			goto EXIT;
+	}
+	else
+		self->nRowsTotal = -1;
+
+	if (bAsync) {
+		// the worker's own connection would not see what has not been committed here yet, run synchronously then
+		if ((pyInTransaction = PyObject_GetAttrString(self->pyConnection, "in_transaction")) == NULL)
+			goto EXIT;
+		iInTransaction = PyObject_IsTrue(pyInTransaction);
+		Py_DECREF(pyInTransaction);
+		if (iInTransaction == -1)
+			goto EXIT;
+		bAsync = !iInTransaction;
+	}
+	if (bAsync) {
+		// an in-memory database can not be opened a second time, run synchronously then
+		if ((pyDatabase = PxDynaset_DatabaseFile(self)) == NULL)
+			goto EXIT;
+		if (PyUnicode_GetLength(pyDatabase) > 0) {
+			bOk = PxDynaset_StartQuery(self, PyUnicode_AsUTF8(pyDatabase), pyParameters);
+			Py_DECREF(pyDatabase);
+			if (bOk) {
+				Py_INCREF(Py_None);
+				pyResult = Py_None;
+			}
+			goto EXIT;
+		}
+		Py_DECREF(pyDatabase);
+	}
+
+	if (self->bDirect) {
+		pyResult = PxDynaset_ExecuteDirect(self, pyPageQuery, pyParameters);
+		goto EXIT;
+	}
+
+	if ((self->pyCursor = PyObject_CallMethod(self->pyConnection, "cursor", NULL)) == NULL)
+		goto EXIT;
+
+	const char* sQuery = PyUnicode_AsUTF8(pyPageQuery ? pyPageQuery : self->pyQuery);
+	if (pyParameters)
+		pyItem = PyObject_CallMethod(self->pyCursor, "execute", "(sO)", sQuery, pyParameters);
+	else
+		pyItem = PyObject_CallMethod(self->pyCursor, "execute", "(s)", sQuery);
+	if (pyItem == NULL)
+		goto EXIT;
+	Py_DECREF(pyItem); // just the cursor again
+
+	if ((pyColumnDescriptions = PyObject_GetAttrString(self->pyCursor, "description")) == NULL ||
+		(pyIterator = PyObject_GetIter(pyColumnDescriptions)) == NULL)
+		goto EXIT;
+
+	PxDynaset_UnmapColumns(self);
+	while ((pyItem = PyIter_Next(pyIterator)) != NULL) {
+		pyColumnName = PyTuple_GetItem(pyItem, 0);
+		bOk = pyColumnName != NULL && PxDynaset_MapColumn(self, pyColumnName, nIndex);
+		Py_DECREF(pyItem);
+		if (!bOk)
+			goto EXIT;
+		nIndex++;
+	}
+	if (PyErr_Occurred())
+		goto EXIT;
+	PxDynaset_MapComputedColumns(self);
+
+	if (self->bColumnar && !PxDynaset_CreateStore(self, self->nDataColumns))
+		goto EXIT;
+
+	// create Dynaset rows from the first window of query result tuples, or all of them
+	self->nRows = 0;
+	self->bFetchComplete = false;
+	if (PxDynaset_Fetch(self, self->nFetchSize > 0 ? self->nFetchSize : -1) == -1)
+		goto EXIT;
+
+	if (PxDynaset_Executed(self))
+		pyResult = PyLong_FromSsize_t(self->nRows);
+
+EXIT:
+	Py_XDECREF(pyParameters);
+	Py_XDECREF(pyKey);
+	Py_XDECREF(pyPageQuery);
+	Py_XDECREF(pyColumnDescriptions);
+	Py_XDECREF(pyIterator);
+	return pyResult;
+}
+
+static PyObject* // new ref
+PxDynaset_execute_async(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "parameters", "query", NULL };
+	PyObject* pyParameters = NULL, *pyQuery = NULL, *pyArgs, *pyKwds, *pyResult;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &pyParameters, &pyQuery))
+		return NULL;
+
+	pyArgs = PyTuple_New(0);
+	pyKwds = Py_BuildValue("{s:O}", "async_", Py_True);
+	if (pyArgs == NULL || pyKwds == NULL ||
+		(pyParameters && PyDict_SetItemString(pyKwds, "parameters", pyParameters) == -1) ||
+		(pyQuery && PyDict_SetItemString(pyKwds, "query", pyQuery) == -1))
+		pyResult = NULL;
+	else
+		pyResult = PxDynaset_execute(self, pyArgs, pyKwds);
+	Py_XDECREF(pyArgs);
+	Py_XDECREF(pyKwds);
+	return pyResult;
+}
+
+static Py_ssize_t
+PxDynaset_FetchDirect(PxDynasetObject* self, Py_ssize_t nMax)
+// PxDynaset_Fetch stepping pStatement, which is finalized once exhausted so it holds no read lock
+{
+	Py_ssize_t nFetched = 0;
+	int iStep = SQLITE_ROW;
+
+	while (nMax == -1 || nFetched < nMax) {
+		if ((iStep = PxQuery_Step(self->pStatement)) == -1)
+			return -1;
+		if (iStep == SQLITE_DONE) {
+			self->bFetchComplete = true;
+			break;
+		}
+		if (!PxDynaset_AppendStatementRow(self))
+			return -1;
+		nFetched++;
+	}
+	// the statement only served the first page, the following ones are read by key
+	if (iStep == SQLITE_DONE || self->bPaged) {
+		PxQuery_Free(self->pStatement);
+		self->pStatement = NULL;
+	}
+	return nFetched;
+}
+
+static Py_ssize_t
+PxDynaset_Fetch(PxDynasetObject* self, Py_ssize_t nMax)
+// pull up to nMax rows (all remaining if -1) from the open cursor, returns the number of rows appended or -1
+{
+	PyObject* pyItem;
+	Py_ssize_t nFetched = 0;
+	bool bOk;
+
+	if (self->bFetchComplete)
+		return 0;
+	if (self->bPaged && self->pyCursor == NULL && self->pStatement == NULL)
+		return PxDynaset_FetchPage(self, 1);
+	if (self->pStatement)
+		return PxDynaset_FetchDirect(self, nMax);
+	if (self->pyCursor == NULL)
+		return 0;
+
+	while (nMax == -1 || nFetched < nMax) {
+		if ((pyItem = PyIter_Next(self->pyCursor)) == NULL) {
+			if (PyErr_Occurred())
+				return -1;
+			self->bFetchComplete = true;
+			break;
+		}
+		bOk = PxDynaset_InsertRow(self, self->nRows, pyItem, 0);
+		Py_DECREF(pyItem);
+		if (!bOk)
+			return -1;
+		nFetched++;
+	}
+	// the cursor only served the first page, the following ones are read by key
+	if (self->bPaged && self->pyCursor) {
+		if ((pyItem = PyObject_CallMethod(self->pyCursor, "close", NULL)) == NULL)
+			return -1;
+		Py_DECREF(pyItem);
+		Py_CLEAR(self->pyCursor);
+	}
+	return nFetched;
+}
+
+bool
+PxDynaset_FetchTo(PxDynasetObject* self, Py_ssize_t nRow)
+// make sure row nRow and half a window beyond it are loaded, -1 to load all remaining rows
+{
+	Py_ssize_t nFirstNewRow = self->nRows;
+
+	if (self->bPaged && nRow == -1) // the whole result is never held, saving works with the rows loaded
+		return true;
+
+	while (!self->bFetchComplete && (nRow == -1 || nRow + self->nFetchSize / 2 >= self->nRows)) {
+		if (PxDynaset_Fetch(self, (nRow == -1 || self->nFetchSize == 0) ? -1 : self->nFetchSize) == -1)
+			return false;
+	}
+
+	if (self->nRows > nFirstNewRow)
+		return PxDynaset_RowsAppended(self, nFirstNewRow);
+	return true;
+}
+
+static bool
+PxDynaset_FetchAll(PxDynasetObject* self, const char* sWhat)
+// load all remaining rows for an operation on the whole result, which a paged Dynaset does not hold
+{
+	if (self->bPaged) {
+		PyErr_Format(PyExc_RuntimeError, "A paged Dynaset does not hold all rows and can not %s.", sWhat);
+		return false;
+	}
+	return PxDynaset_FetchTo(self, -1);
+}
+
+static gboolean
+PxDynaset_FetchIdleCB(gpointer gUserData)
+{
+	PxDynasetObject* self = (PxDynasetObject*)gUserData;
+	self->iFetchSourceID = 0;
+	if (!PxDynaset_FetchTo(self, self->nRows) || (self->bPaged && !PxDynaset_TrimPages(self, true)))
+		PythonErrorDialog();
+	Py_DECREF(self);
+	return G_SOURCE_REMOVE;
+}
+
+void
+PxDynaset_RequestFetch(PxDynasetObject* self)
+// pull the next window from the main loop, for callers that must not change the row count themselves (e.g. a Table while rendering)
+{
+	if (self->bFetchComplete || self->iFetchSourceID)
+		return;
+	Py_INCREF(self); // released by the idle callback
+	self->iFetchSourceID = g_idle_add(PxDynaset_FetchIdleCB, self);
+}
+
+static bool
+PxDynaset_CloseCursor(PxDynasetObject* self)
+{
+	PyObject* pyResult;
+
+	if (self->iFetchSourceID) {
+		g_source_remove(self->iFetchSourceID);
+		self->iFetchSourceID = 0;
+		Py_DECREF(self);
+	}
+	if (self->iPageSourceID) {
+		g_source_remove(self->iPageSourceID);
+		self->iPageSourceID = 0;
+		Py_DECREF(self);
+	}
+	self->bFetchComplete = true;
+
+	if (self->pQuery) { // the running query is superseded, its done callback will discard the result
+		PxQuery_Cancel(self->pQuery);
+		self->pQuery = NULL;
+		PxDynaset_SetLoading(self, false);
+	}
+
+	if (self->pStatement) {
+		PxQuery_Free(self->pStatement);
+		self->pStatement = NULL;
+	}
+	if (self->pyCursor) {
+		if ((pyResult = PyObject_CallMethod(self->pyCursor, "close", NULL)) == NULL)
+			return false;
+		Py_DECREF(pyResult);
+		Py_CLEAR(self->pyCursor);
+	}
+	return true;
+}
+
+static PyObject* // new ref
+PxDynaset_fetch_all(PxDynasetObject* self, PyObject* args)
+{
+	if (!PxDynaset_FetchAll(self, "fetch them"))
+		return NULL;
+	return PyLong_FromSsize_t(self->nRows);
+}
+
+// Merged refresh
+// refresh(merge=True) runs the query again and applies only the difference to the rows loaded, matching rows by their key values.
+// Tables are told which rows have changed, come or gone, so they neither rebuild nor lose their place. Rows with unsaved changes are left alone.
+
+typedef struct _PxMergeInsert
+{
+	Py_ssize_t nAnchor;   // row it goes before, counted after the rows missing from the new result have been removed
+	Py_ssize_t nSource;   // position in the new result
+}
+PxMergeInsert;
+
+static PyObject* // new ref
+PxDynaset_MergeKey(PxDynasetObject* self, PyObject* pyRowData, Py_ssize_t nRow, const Py_ssize_t* pnKeys, Py_ssize_t nKeys)
+// tuple of the key values of a result row or, if pyRowData is NULL, of row nRow
+{
+	PyObject* pyKey, *pyData;
+	Py_ssize_t n;
+
+	if ((pyKey = PyTuple_New(nKeys)) == NULL)
+		return NULL;
+	for (n = 0; n < nKeys; n++) {
+		pyData = pyRowData ? PySequence_GetItem(pyRowData, pnKeys[n]) : PxDynaset_GetCell(self, nRow, pnKeys[n]);
+		if (pyData == NULL) {
+			Py_DECREF(pyKey);
+			return NULL;
+		}
+		PyTuple_SET_ITEM(pyKey, n, pyData);
+	}
+	return pyKey;
+}
+
+static int
+PxDynaset_CompareMergeInserts(gconstpointer pA, gconstpointer pB, gpointer pUserData)
+{
+	const PxMergeInsert* pInsertA = pA, *pInsertB = pB;
+
+	if (pInsertA->nAnchor != pInsertB->nAnchor)
+		return pInsertA->nAnchor < pInsertB->nAnchor ? -1 : 1;
+	return pInsertA->nSource < pInsertB->nSource ? -1 : (pInsertA->nSource > pInsertB->nSource);
+}
+
+static int
+PxDynaset_SameColumns(PxDynasetObject* self, PyObject* pyCursor)
+// 1 if the cursor's columns are mapped to the same positions as those of the rows loaded, 0 if not, -1 on error
+{
+	PyObject* pyDescription, *pyItem, *pyName, *pyColumn;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t n, nColumns = 0;
+	int iSame;
+
+	if ((pyDescription = PyObject_GetAttrString(pyCursor, "description")) == NULL)
+		return -1;
+	iSame = PySequence_Check(pyDescription) && (nColumns = PySequence_Size(pyDescription)) <= self->nDataColumns;
+	for (n = 0; iSame && n < nColumns; n++) {
+		if ((pyItem = PySequence_GetItem(pyDescription, n)) == NULL || (pyName = PyTuple_GetItem(pyItem, 0)) == NULL) {
+			Py_XDECREF(pyItem);
+			Py_DECREF(pyDescription);
+			return -1;
+		}
+		pyColumn = PyDict_GetItem(self->pyColumns, pyName);
+		Py_DECREF(pyItem);
+		pInfo = pyColumn ? PxDynaset_FindColumn(self, pyColumn) : NULL;
+		iSame = pInfo && pInfo->nIndex == n;
+	}
+	Py_DECREF(pyDescription);
+	// the positions after the query's columns are those of computed columns
+	for (pInfo = self->pColumnInfo; iSame && pInfo < self->pColumnInfo + self->nColumnInfo; pInfo++)
+		if (pInfo->pyExpr && pInfo->nIndex >= nColumns)
+			nColumns++;
+	return iSame && nColumns == self->nDataColumns;
+}
+
+static int
+PxDynaset_Merge(PxDynasetObject* self)
+// run the query again and bring the rows loaded in line with the new result, 1 if done, 0 if the result has other columns, -1 on error
+{
+	PyObject* pyCursor = NULL, *pyResult = NULL, *pyIndex = NULL, *pyKey, *pyPosition, *pyRowData, *pyOld, *pyNew, *pyArgs;
+	Py_ssize_t* pnKeys = NULL, *pnRemove = NULL, *pnMatch = NULL, n, c, nKeys = 0, nNew, nRemove = 0, nInserts = 0, nAnchor, nFirst, nCurrent;
+	PxMergeInsert* pInserts = NULL;
+	PxDynasetColumnInfo* pInfo;
+	bool bCurrentGone = false;
+	int iResult = -1, iSame;
+
+	if (!PxDynaset_FetchTo(self, -1) || !PxDynaset_WatchStamp(self))
+		return -1;
+
+	if (self->pyParameters)
+		pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(OO)", self->pyQuery, self->pyParameters);
+	else
+		pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(O)", self->pyQuery);
+	if (pyCursor == NULL)
+		return -1;
+	if ((iSame = PxDynaset_SameColumns(self, pyCursor)) != 1) {
+		iResult = iSame;
+		goto ERROR;
+	}
+	if ((pyResult = PySequence_Fast(pyCursor, "")) == NULL)
+		goto ERROR;
+	nNew = PySequence_Fast_GET_SIZE(pyResult);
+
+	pnKeys = (Py_ssize_t*)PyMem_RawMalloc((self->nColumnInfo + 1) * sizeof(Py_ssize_t));
+	pnRemove = (Py_ssize_t*)PyMem_RawMalloc((self->nRows + 1) * sizeof(Py_ssize_t));
+	pnMatch = (Py_ssize_t*)PyMem_RawMalloc((nNew + 1) * sizeof(Py_ssize_t));
+	pInserts = (PxMergeInsert*)PyMem_RawMalloc((nNew + 1) * sizeof(PxMergeInsert));
+	if (pnKeys == NULL || pnRemove == NULL || pnMatch == NULL || pInserts == NULL) {
+		PyErr_NoMemory();
+		goto ERROR;
+	}
+	for (n = 0; n < self->nColumnInfo; n++)
+		if (self->pColumnInfo[n].iKey == 1 && self->pColumnInfo[n].nIndex != -1)
+			pnKeys[nKeys++] = self->pColumnInfo[n].nIndex;
+	if (nKeys == 0) {
+		PyErr_SetString(PyExc_RuntimeError, "Merging needs key columns.");
+		goto ERROR;
+	}
+
+	// position of each new row by key
+	if ((pyIndex = PyDict_New()) == NULL)
+		goto ERROR;
+	for (n = 0; n < nNew; n++) {
+		pnMatch[n] = -1;
+		if ((pyKey = PxDynaset_MergeKey(self, PySequence_Fast_GET_ITEM(pyResult, n), -1, pnKeys, nKeys)) == NULL)
+			goto ERROR;
+		pyPosition = PyLong_FromSsize_t(n);
+		c = pyPosition ? PyDict_SetItem(pyIndex, pyKey, pyPosition) : -1;
+		Py_DECREF(pyKey);
+		Py_XDECREF(pyPosition);
+		if (c == -1)
+			goto ERROR;
+	}
+
+	// update the rows still there in place, note the ones gone; pnMatch gets where each new row already is, counted without the rows gone
+	for (n = 0; n < self->nRows; n++) {
+		if (PxDynaset_GetRowState(self, n) & PxROW_NEW)
+			continue;
+		if ((pyKey = PxDynaset_MergeKey(self, NULL, n, pnKeys, nKeys)) == NULL)
+			goto ERROR;
+		pyPosition = PyDict_GetItemWithError(pyIndex, pyKey);
+		Py_DECREF(pyKey);
+		if (pyPosition == NULL) {
+			if (PyErr_Occurred())
+				goto ERROR;
+			if (PxDynaset_GetRowState(self, n) == 0) {
+				bCurrentGone |= n == self->nRow;
+				pnRemove[nRemove++] = n;
+			}
+			continue;
+		}
+		pnMatch[PyLong_AsSsize_t(pyPosition)] = n - nRemove;
+		if (PxDynaset_GetRowState(self, n) != 0)
+			continue;
+
+		pyRowData = PySequence_Fast_GET_ITEM(pyResult, PyLong_AsSsize_t(pyPosition));
+		for (pInfo = self->pColumnInfo; pInfo < self->pColumnInfo + self->nColumnInfo; pInfo++) {
+			if ((c = pInfo->nIndex) == -1 || pInfo->pyExpr) // computed cells follow the others
+				continue;
+			pyOld = PxDynaset_GetCell(self, n, c);
+			pyNew = PySequence_GetItem(pyRowData, c);
+			iSame = (pyOld && pyNew) ? PyObject_RichCompareBool(pyOld, pyNew, Py_EQ) : -1;
+			if (iSame == 0 && (!PxDynaset_PutCell(self, n, c, pyNew) || !PxDynaset_DataChanged(self, n, pInfo->pyColumn)))
+				iSame = -1;
+			Py_XDECREF(pyOld);
+			Py_XDECREF(pyNew);
+			if (iSame == -1)
+				goto ERROR;
+		}
+	}
+
+	// remove the rows gone and let tables follow, last run first so the row numbers told stay valid
+	nCurrent = self->nRow;
+	for (n = 0; n < nRemove && pnRemove[n] <= self->nRow; n++)
+		nCurrent--;
+	if (bCurrentGone)
+		nCurrent++; // the row that has taken its place
+	if (!PxDynaset_RemoveRows(self, pnRemove, nRemove))
+		goto ERROR;
+	self->nRow = bCurrentGone ? -1 : nCurrent;
+	for (n = nRemove; n > 0; n = nFirst) {
+		for (nFirst = n - 1; nFirst > 0 && pnRemove[nFirst - 1] == pnRemove[nFirst] - 1; nFirst--);
+		if (!PxDynaset_RowsShifted(self, pnRemove[nFirst], nFirst - n))
+			goto ERROR;
+	}
+
+	// each new row goes after the row preceding it in the new result
+	nAnchor = 0;
+	for (n = 0; n < nNew; n++) {
+		if (pnMatch[n] != -1)
+			nAnchor = pnMatch[n] + 1;
+		else {
+			pInserts[nInserts].nAnchor = nAnchor;
+			pInserts[nInserts++].nSource = n;
+		}
+	}
+	g_qsort_with_data(pInserts, (gint)nInserts, sizeof(PxMergeInsert), PxDynaset_CompareMergeInserts, NULL);
+	for (n = 0; n < nInserts; n++) {
+		c = pInserts[n].nAnchor + n;
+		if (!PxDynaset_InsertRow(self, c, PySequence_Fast_GET_ITEM(pyResult, pInserts[n].nSource), 0))
+			goto ERROR;
+		if (nCurrent >= c)
+			nCurrent++;
+		if (self->nRow >= c)
+			self->nRow++;
+	}
+	for (n = 0; n < nInserts; n = nFirst) {
+		for (nFirst = n + 1; nFirst < nInserts && pInserts[nFirst].nAnchor == pInserts[n].nAnchor; nFirst++);
+		if (!PxDynaset_RowsShifted(self, pInserts[n].nAnchor + n, nFirst - n))
+			goto ERROR;
+	}
+
+	if (bCurrentGone) {
+		if (nCurrent >= self->nRows)
+			nCurrent = self->nRows - 1;
+		if (!PxDynaset_MoveRow(self, nCurrent, true))
+			goto ERROR;
+	}
+	else
+		PxDynaset_UpdateControlWidgets(self);
+
+	if ((nRemove > 0 || nInserts > 0) && self->pyOnChangedCB) {
+		pyArgs = Py_BuildValue("(OiO)", (PyObject*)self, -1, Py_None);
+		pyNew = pyArgs ? PyObject_CallObject(self->pyOnChangedCB, pyArgs) : NULL;
+		Py_XDECREF(pyArgs);
+		if (pyNew == NULL)
+			goto ERROR;
+		Py_DECREF(pyNew);
+	}
+	iResult = 1;
+
+ERROR:
+	Py_XDECREF(pyCursor);
+	Py_XDECREF(pyResult);
+	Py_XDECREF(pyIndex);
+	PyMem_RawFree(pnKeys);
+	PyMem_RawFree(pnRemove);
+	PyMem_RawFree(pnMatch);
+	PyMem_RawFree(pInserts);
+	return iResult;
+}
+
+static PyObject* // new ref
+PxDynaset_Reexecute(PxDynasetObject* self)
+// execute with the parameters last used, a child Dynaset takes them from the parent's current row again
+{
+	PyObject* pyArgs, *pyResult;
+
+	if (self->pyParent || self->pyParameters == NULL)
+		return PxDynaset_execute(self, NULL, NULL);
+	if ((pyArgs = PyTuple_Pack(1, self->pyParameters)) == NULL)
+		return NULL;
+	pyResult = PxDynaset_execute(self, pyArgs, NULL);
+	Py_DECREF(pyArgs);
+	return pyResult;
+}
+
+static PyObject* // new ref
+PxDynaset_Refresh(PxDynasetObject* self, bool bMerge)
+// run the query again, returns the number of rows
+{
+	int iMerged;
+
+	// nothing loaded yet to merge into
+	if (!bMerge || self->nDataColumns == 0 || self->pQuery || self->pyQuery == NULL)
+		return PxDynaset_Reexecute(self);
+
+	if (self->bPaged) {
+		PyErr_SetString(PyExc_RuntimeError, "A paged Dynaset can not be refreshed by merging.");
+		return NULL;
+	}
+	if ((iMerged = PxDynaset_Merge(self)) == -1)
+		return NULL;
+	if (iMerged == 0) // the query now returns other columns
+		return PxDynaset_Reexecute(self);
+	return PyLong_FromSsize_t(self->nRows);
+}
+
+static PyObject* // new ref
+PxDynaset_refresh(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "merge", NULL };
+	int bMerge = false;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &bMerge))
+		return NULL;
+	return PxDynaset_Refresh(self, bMerge);
+}
+
+// Watching for changes
+// A Dynaset with watchInterval set polls PRAGMA data_version, which changes when another connection, of this process or another one, has committed.
+// Writes through this connection cannot be seen that way, so saving Dynasets mark those watching the same table directly.
+// Only a save that commits does so, one inside a transaction opened elsewhere leaves refreshing the watchers to whoever commits it.
+// A stale Dynaset with autoRefresh merges the new result in once it has no unsaved changes of its own.
+
+static GSList* pWatching = NULL; // Dynasets with a watch source, not referenced
+
+static bool
+PxDynaset_WatchStamp(PxDynasetObject* self)
+// the rows are about to be loaded, note the data_version they reflect
+{
+	long long iChanges;
+
+	self->bStale = false;
+	if (self->iWatchSourceID == 0)
+		return true;
+	return PxDynaset_CacheStamp(self, &iChanges, &self->iWatchVersion);
+}
+
+static void
+PxDynaset_StopWatching(PxDynasetObject* self)
+{
+	if (self->iWatchSourceID) {
+		g_source_remove(self->iWatchSourceID);
+		self->iWatchSourceID = 0;
+		pWatching = g_slist_remove(pWatching, self);
+	}
+}
+
+static gboolean
+PxDynaset_WatchCB(gpointer gUserData)
+{
+	PxDynasetObject* self = (PxDynasetObject*)gUserData;
+	PyObject* pyResult;
+	long long iChanges, iVersion;
+	bool bMerge = false;
+	Py_ssize_t n;
+
+	if (self->nDataColumns == 0 || self->bLoading) // nothing to compare with yet
+		return G_SOURCE_CONTINUE;
+
+	if (!self->bStale) {
+		if (!PxDynaset_CacheStamp(self, &iChanges, &iVersion))
+			goto ERROR;
+		self->bStale = iVersion != self->iWatchVersion;
+	}
+	if (!self->bStale || !self->bAutoRefresh || self->bPaged || PxDynaset_HasDirtyRows(self))
+		return G_SOURCE_CONTINUE;
+
+	// without key columns the rows cannot be matched, they are loaded anew
+	for (n = 0; n < self->nColumnInfo; n++)
+		if (self->pColumnInfo[n].iKey == 1 && self->pColumnInfo[n].nIndex != -1)
+			bMerge = true;
+	if ((pyResult = PxDynaset_Refresh(self, bMerge)) == NULL)
+		goto ERROR;
+	Py_DECREF(pyResult);
+	return G_SOURCE_CONTINUE;
+
+ERROR: // reporting the same failure on every tick would not help, stop
+	self->iWatchSourceID = 0;
+	pWatching = g_slist_remove(pWatching, self);
+	PythonErrorDialog();
+	return G_SOURCE_REMOVE;
+}
+
+static bool
+PxDynaset_Watch(PxDynasetObject* self, int iInterval)
+// check for changes every iInterval ms, 0 to stop
+{
+	PxDynaset_StopWatching(self);
+	self->iWatchInterval = iInterval > 0 ? iInterval : 0;
+	if (self->iWatchInterval == 0)
+		return true;
+	self->iWatchSourceID = g_timeout_add(self->iWatchInterval, PxDynaset_WatchCB, self);
+	pWatching = g_slist_prepend(pWatching, self);
+	return self->nDataColumns == 0 || PxDynaset_WatchStamp(self);
+}
+
+static void
+PxDynaset_AnnounceWrites(PxDynasetObject* self)
+// the changed rows of the tree have been committed, Dynasets watching their tables through the same connection are stale now
+{
+	PxDynasetObject* pyWatching;
+	GSList* pItem;
+	Py_ssize_t n, nLen;
+
+	if (pWatching && PxDynaset_HasDirtyRows(self))
+		for (pItem = pWatching; pItem; pItem = pItem->next) {
+			pyWatching = (PxDynasetObject*)pItem->data;
+			if (pyWatching != self && pyWatching->pyConnection == self->pyConnection && PyUnicode_Compare(pyWatching->pyTable, self->pyTable) == 0)
+				pyWatching->bStale = true;
+		}
+
+	nLen = PySequence_Size(self->pyChildren);
+	for (n = 0; n < nLen; n++)
+		PxDynaset_AnnounceWrites((PxDynasetObject*)PyList_GetItem(self->pyChildren, n));
+}
+
+PyObject* // new ref
+PxDynaset_GetRowDataDict(PxDynasetObject* self, Py_ssize_t nRow, bool bKeysOnly)
+{
+	PyObject* pyRowData, *pyData, *pyRowDataDict;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t n;
+	if (nRow == -1)
+		nRow = self->nRow;
+	if (nRow == -1)
+		Py_RETURN_NONE;
+	if ((pyRowData = PxDynaset_GetRowTuple(self, nRow)) == NULL)
+		return NULL;
+	if ((pyRowDataDict = PyDict_New()) == NULL) {
+		Py_DECREF(pyRowData);
+		return NULL;
+	}
+
+	for (n = 0; n < self->nColumnInfo; n++) {
+		pInfo = self->pColumnInfo + n;
+		if (pInfo->nIndex == -1 || (bKeysOnly && pInfo->iKey != 1))
+			continue;
+		pyData = PyTuple_GET_ITEM(pyRowData, pInfo->nIndex);
+		if (PyDict_SetItem(pyRowDataDict, PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_NAME), pyData) == -1) { // PyDict_SetItem increfs...
+			Py_DECREF(pyRowData);
+			Py_DECREF(pyRowDataDict);
+			return NULL;
+		}
+	}
+	Py_DECREF(pyRowData);
+	return pyRowDataDict;
+}
+
+static bool
+PxDynaset_UpdateAutoColumnInChildren(PxDynasetObject* self, PyObject* pyParentColumn, PyObject* pyLastRowID)
+{
+	PxDynasetObject* pyChild;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t n, nLen, nRow, nInfo;
+
+	nLen = PySequence_Size(self->pyChildren);
+	for (n = 0; n < nLen; n++) {
+		pyChild = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
+		for (nInfo = 0; nInfo < pyChild->nColumnInfo; nInfo++) {
+			pInfo = pyChild->pColumnInfo + nInfo;
+			if (pInfo->pyParentColumn == pyParentColumn) {
+				if (pInfo->nIndex != -1)
+					for (nRow = 0; nRow < pyChild->nRows; nRow++)
+						if (!PxDynaset_PutCell(pyChild, nRow, pInfo->nIndex, pyLastRowID))
+							return false;
+				if (!PxDynaset_UpdateAutoColumnInChildren(pyChild, pInfo->pyColumn, pyLastRowID))
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+static PxDynasetStatement*
+PxDynaset_GetStatement(PxDynasetObject* self, int iKind)
+// SQL for writing a row back, generated once for the current column set and reused for every row
+{
+	PxDynasetStatement* pStatement;
+	PxDynasetColumnInfo* pInfo;
+	PyObject* pyColumnName, *pyParts, *pyEmpty;
+	Py_ssize_t nPos, nPass, nParams = 0, nSet = 0, nWhere = 0;
+	Py_ssize_t nColumns = self->nColumnInfo;
+	int iResult = 0;
+
+	if (self->pStatements[iKind])
+		return self->pStatements[iKind];
+
+	if ((pStatement = (PxDynasetStatement*)PyMem_RawCalloc(1, sizeof(PxDynasetStatement))) == NULL ||
+		(pStatement->pnColumns = (Py_ssize_t*)PyMem_RawMalloc((nColumns ? nColumns : 1) * sizeof(Py_ssize_t))) == NULL) {
+		PyMem_RawFree(pStatement);
+		PyErr_NoMemory();
+		return NULL;
+	}
+	if ((pyParts = PyList_New(0)) == NULL)
+		goto ERROR;
+
+	switch (iKind) {
+	case PxSTATEMENT_INSERT:
+		iResult |= PxListAppendString(pyParts, "INSERT INTO ");
+		iResult |= PyList_Append(pyParts, self->pyTable);
+		iResult |= PxListAppendString(pyParts, " (");
+		break;
+	case PxSTATEMENT_UPDATE:
+		iResult |= PxListAppendString(pyParts, "UPDATE ");
+		iResult |= PyList_Append(pyParts, self->pyTable);
+		iResult |= PxListAppendString(pyParts, " SET ");
+		break;
+	case PxSTATEMENT_DELETE:
+		iResult |= PxListAppendString(pyParts, "DELETE FROM ");
+		iResult |= PyList_Append(pyParts, self->pyTable);
+		iResult |= PxListAppendString(pyParts, " WHERE ");
+		break;
+	}
+
+	// UPDATE needs two passes: non-key columns to SET first, then key columns for WHERE
+	for (nPass = 0; nPass < (iKind == PxSTATEMENT_UPDATE ? 2 : 1); nPass++) {
+		if (nPass == 1)
+			iResult |= PxListAppendString(pyParts, " WHERE ");
+		for (nPos = 0; nPos < self->nColumnInfo; nPos++) {
+			pInfo = self->pColumnInfo + nPos;
+			pyColumnName = PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_NAME);
+			if (iKind == PxSTATEMENT_INSERT) {
+				if (pInfo->iKey == -1 || pInfo->pyColumn == self->pyAutoColumn)
+					continue;
+				if (nParams > 0)
+					iResult |= PxListAppendString(pyParts, ",");
+				iResult |= PyList_Append(pyParts, pyColumnName);
+			}
+			else if (iKind == PxSTATEMENT_UPDATE && nPass == 0) {
+				if (pInfo->iKey != 0)
+					continue;
+				if (nSet++ > 0)
+					iResult |= PxListAppendString(pyParts, ",");
+				iResult |= PyList_Append(pyParts, pyColumnName);
+				iResult |= PxListAppendString(pyParts, "=?");
+			}
+			else {
+				if (pInfo->iKey != 1)
+					continue;
+				if (nWhere++ > 0)
+					iResult |= PxListAppendString(pyParts, " AND ");
+				iResult |= PyList_Append(pyParts, pyColumnName);
+				iResult |= PxListAppendString(pyParts, "=?");
+			}
+			if (pInfo->nIndex == -1) {
+				PxDynaset_ColumnIndex(pInfo->pyColumn); // sets the exception
+				goto ERROR;
+			}
+			pStatement->pnColumns[nParams++] = pInfo->nIndex;
+		}
+	}
+
+	if (iKind == PxSTATEMENT_INSERT) {
+		if (nParams == 0) {
+			PyErr_SetString(PyExc_RuntimeError, "No columns.");
+			goto ERROR;
+		}
+		iResult |= PxListAppendString(pyParts, ") VALUES (?");
+		for (nPos = 1; nPos < nParams; nPos++)
+			iResult |= PxListAppendString(pyParts, ",?");
+		iResult |= PxListAppendString(pyParts, ");");
+	}
+	else {
+		if (nWhere == 0) {
+			PyErr_SetString(PyExc_RuntimeError, iKind == PxSTATEMENT_UPDATE ? "No key columns given. Can not update." : "No key columns. Can not delete.");
+			goto ERROR;
+		}
+		if (iKind == PxSTATEMENT_UPDATE && nSet == 0) {
+			PyErr_SetString(PyExc_RuntimeError, "No non-key columns. Nothing to update.");
+			goto ERROR;
+		}
+		iResult |= PxListAppendString(pyParts, ";");
+	}
+	if (iResult != 0)
+		goto ERROR;
+
+	if ((pyEmpty = PyUnicode_New(0, 0)) == NULL)
+		goto ERROR;
+	pStatement->pySQL = PyUnicode_Join(pyEmpty, pyParts);
+	Py_DECREF(pyEmpty);
+	if (pStatement->pySQL == NULL)
+		goto ERROR;
+	Py_DECREF(pyParts);
+	pStatement->nParams = nParams;
+	self->pStatements[iKind] = pStatement;
+	return pStatement;
+
+ERROR:
+	Py_XDECREF(pyParts);
+	PyMem_RawFree(pStatement->pnColumns);
+	PyMem_RawFree(pStatement);
+	return NULL;
+}
+
+static PyObject* // new ref
+PxDynaset_BindParameters(PxDynasetStatement* pStatement, PyObject* pyRowData)
+// tuple of the row's data the statement's parameters refer to
+{
+	PyObject* pyParams, *pyData;
+	Py_ssize_t n;
+
+	if ((pyParams = PyTuple_New(pStatement->nParams)) == NULL)
+		return NULL;
+	for (n = 0; n < pStatement->nParams; n++) {
+		if ((pyData = PyTuple_GetItem(pyRowData, pStatement->pnColumns[n])) == NULL) {
+			Py_DECREF(pyParams);
+			return NULL;
+		}
+		Py_INCREF(pyData);
+		PyTuple_SET_ITEM(pyParams, n, pyData);
+	}
+	return pyParams;
+}
+
+static void
+PxDynaset_ForgetStatements(PxDynasetObject* self)
+// the column set has changed, the statements have to be generated anew
+{
+	int i;
+	for (i = PxSTATEMENT_INSERT; i <= PxSTATEMENT_DELETE; i++) {
+		if (self->pStatements[i]) {
+			Py_XDECREF(self->pStatements[i]->pySQL);
+			PyMem_RawFree(self->pStatements[i]->pnColumns);
+			PyMem_RawFree(self->pStatements[i]);
+			self->pStatements[i] = NULL;
+		}
+	}
+}
+
+static bool
+PxDynaset_ExecuteSQL(PxDynasetObject* self, const char* sSQL)
+// run a statement that returns no rows
+{
+	PyObject* pyCursor;
+
+	if ((pyCursor = PyObject_CallMethod(self->pyConnection, "execute", "(s)", sSQL)) == NULL)
+		return false;
+	Py_DECREF(pyCursor);
+	return true;
+}
+
+static void
+PxDynaset_RollbackTo(PxDynasetObject* self, const char* sSavepoint)
+// take back the writes since the savepoint after a failure, the exception raised is kept
+{
+	PyObject* pyType, *pyValue, *pyTraceback, *pyOk;
+	char sSQL[60];
+
+	PyErr_Fetch(&pyType, &pyValue, &pyTraceback);
+	if (sSavepoint) {
+		sprintf(sSQL, "ROLLBACK TO %s;", sSavepoint);
+		if (PxDynaset_ExecuteSQL(self, sSQL)) {
+			sprintf(sSQL, "RELEASE %s;", sSavepoint);
+			PxDynaset_ExecuteSQL(self, sSQL);
+		}
+	}
+	else if ((pyOk = PyObject_CallMethod(self->pyConnection, "rollback", NULL)) != NULL)
+		Py_DECREF(pyOk);
+	PyErr_Clear();
+	PyErr_Restore(pyType, pyValue, pyTraceback);
+}
+
+bool
+PxDynaset_Save(PxDynasetObject* self)
+// write the whole tree of Dynasets in one transaction with a single commit
+{
+	int iRecordsChanged = 0, iInTransaction;
+	PyObject* pyOk;
+	bool bOk;
+	char sMessage[30];
+
+	// a rollback would abort a pending read, so pull the remaining rows first
+	if (!PxDynaset_FetchTo(self, -1))
+		return false;
+	if (!PxDynaset_FlushChildRefresh(self))
+		return false;
+
+	// inside a transaction opened elsewhere the writes go under a savepoint and committing is left to its owner
+	if ((pyOk = PyObject_GetAttrString(self->pyConnection, "in_transaction")) == NULL)
+		return false;
+	iInTransaction = PyObject_IsTrue(pyOk);
+	Py_DECREF(pyOk);
+	if (iInTransaction == -1 || !PxDynaset_ExecuteSQL(self, iInTransaction ? "SAVEPOINT pylax_save;" : "BEGIN;"))
+		return false;
+
+	iRecordsChanged = PxDynaset_Write(self);
+	if (iRecordsChanged == -1) {
+		PxDynaset_RollbackTo(self, iInTransaction ? "pylax_save" : NULL);
+		return false;
+	}
+
+	if (iInTransaction)
+		bOk = PxDynaset_ExecuteSQL(self, "RELEASE pylax_save;");
+	else if ((bOk = (pyOk = PyObject_CallMethod(self->pyConnection, "commit", NULL)) != NULL))
+		Py_DECREF(pyOk);
+	if (!bOk) {
+		PxDynaset_RollbackTo(self, iInTransaction ? "pylax_save" : NULL);
+		return false;
+	}
+
+	// the owner of an outer transaction may still roll it back, watching Dynasets are left for it to refresh
+	if (!iInTransaction)
+		PxDynaset_AnnounceWrites(self);
+	if (!PxDynaset_CleanUp(self))
+		return false;
+	if (!PxDynaset_Thaw(self))
+		return false;
+	sprintf(sMessage, "Records updated: %d", iRecordsChanged);
+	gtk_statusbar_push(g.gtkStatusbar, 1, sMessage);
+	return true;
+}
+
+static bool
+PxDynaset_InsertOneByOne(PxDynasetObject* self, PxDynasetStatement* pStatement, PyObject* pyBatch, Py_ssize_t* pnRows)
+// new rows whose auto column gets populated by the database need the ID of each insert back
+{
+	PyObject* pyCursor, *pyResult, *pyParams, *pyLastRowID;
+	Py_ssize_t n, nAutoColumn = PxDynaset_ColumnIndex(self->pyAutoColumn);
+	bool bOk = true;
+
+	if ((pyCursor = PyObject_CallMethod(self->pyConnection, "cursor", NULL)) == NULL)
+		return false;
+
+	for (n = 0; bOk && n < PyList_GET_SIZE(pyBatch); n++) {
+		pyParams = PyList_GET_ITEM(pyBatch, n);
+		if ((pyResult = PyObject_CallMethod(pyCursor, "execute", "(OO)", pStatement->pySQL, pyParams)) == NULL) {
+			bOk = false;
+			break;
+		}
+		Py_DECREF(pyResult);
+
+		if ((pyLastRowID = PyObject_GetAttrString(pyCursor, "lastrowid")) == NULL) {
+			bOk = false;
+			break;
+		}
+		if (pyLastRowID == Py_None)
+			self->iLastRowID = -1;
+		else {
+			self->iLastRowID = PyLong_AsLong(pyLastRowID);
+			bOk = PxDynaset_PutCell(self, pnRows[n], nAutoColumn, pyLastRowID);
+			// loaded child rows belong to the current row only
+			if (bOk && pnRows[n] == self->nRow)
+				bOk = PxDynaset_UpdateAutoColumnInChildren(self, self->pyAutoColumn, pyLastRowID);
+		}
+		Py_DECREF(pyLastRowID);
+	}
+
+	if ((pyResult = PyObject_CallMethod(pyCursor, "close", NULL)) == NULL)
+		bOk = false;
+	Py_XDECREF(pyResult);
+	Py_DECREF(pyCursor);
+	return bOk;
+}
+
+static PyObject* // new ref
+PxDynaset_ParameterBatch(PxDynasetObject* self, PxDynasetStatement* pStatement, const Py_ssize_t* pnRows, Py_ssize_t nCount)
+// list of the parameter tuples of the rows for executemany
+{
+	PyObject* pyBatch, *pyRowData, *pyParams;
+	Py_ssize_t n;
+
+	if ((pyBatch = PyList_New(nCount)) == NULL)
+		return NULL;
+	for (n = 0; n < nCount; n++) {
+		if ((pyRowData = PxDynaset_GetRowTuple(self, pnRows[n])) == NULL) {
+			Py_DECREF(pyBatch);
+			return NULL;
+		}
+		pyParams = PxDynaset_BindParameters(pStatement, pyRowData);
+		Py_DECREF(pyRowData);
+		if (pyParams == NULL) {
+			Py_DECREF(pyBatch);
+			return NULL;
+		}
+		PyList_SET_ITEM(pyBatch, n, pyParams);
+	}
+	return pyBatch;
+}
+
+static bool
+PxDynaset_WriteDirect(PxDynasetObject* self, PxDynasetStatement* pStatement, bool bAutoColumn, const Py_ssize_t* pnRows, Py_ssize_t nCount)
+// run the statement prepared once on the connection's handle for each row, binding the cells without a parameter tuple
+{
+	PxQuery* pQuery;
+	PyObject* pyRowData = NULL, *pyLastRowID;
+	Py_ssize_t n, nParam, nAutoColumn = bAutoColumn ? PxDynaset_ColumnIndex(self->pyAutoColumn) : -1;
+	sqlite3* pDb;
+	bool bOk = true;
+
+	if ((pDb = PxQuery_Handle(self->pyConnection)) == NULL || (pQuery = PxQuery_Prepare(pDb, pStatement->pySQL, NULL)) == NULL)
+		return false;
+
+	for (n = 0; bOk && n < nCount; n++) {
+		if (self->pStore == NULL)
+			pyRowData = PyStructSequence_GET_ITEM(PyList_GET_ITEM(self->pyRows, pnRows[n]), PXDYNASETROW_DATA); // borrowed ref
+		for (nParam = 0; bOk && nParam < pStatement->nParams; nParam++) {
+			if (self->pStore)
+				bOk = PxColumnStore_BindItem(self->pStore, pnRows[n], pStatement->pnColumns[nParam], pQuery, (int)nParam + 1);
+			else
+				bOk = PxQuery_BindValue(pQuery, (int)nParam + 1, PyTuple_GET_ITEM(pyRowData, pStatement->pnColumns[nParam]));
+		}
+		if (bOk)
+			bOk = PxQuery_Step(pQuery) != -1;
+		PxQuery_Reset(pQuery);
+
+		// as PxDynaset_InsertOneByOne
+		if (bOk && bAutoColumn) {
+			self->iLastRowID = (long)sqlite3_last_insert_rowid(pDb);
+			if ((pyLastRowID = PyLong_FromLongLong(sqlite3_last_insert_rowid(pDb))) == NULL)
+				bOk = false;
+			else {
+				bOk = PxDynaset_PutCell(self, pnRows[n], nAutoColumn, pyLastRowID);
+				if (bOk && pnRows[n] == self->nRow)
+					bOk = PxDynaset_UpdateAutoColumnInChildren(self, self->pyAutoColumn, pyLastRowID);
+				Py_DECREF(pyLastRowID);
+			}
+		}
+	}
+	PxQuery_Free(pQuery);
+	return bOk;
+}
+
+static int
+PxDynaset_Write(PxDynasetObject* self)
+{
+	static const int iOrder[] = { PxSTATEMENT_DELETE, PxSTATEMENT_UPDATE, PxSTATEMENT_INSERT }; // deletes first, they may free keys new rows reuse
+	Py_ssize_t* pnRows[3] = { NULL, NULL, NULL }; // rows to write with each kind of statement
+	Py_ssize_t nRows[3] = { 0, 0, 0 };
+	PyObject* pyBatch, *pyCursor;
+	PxDynasetStatement* pStatement;
+	Py_ssize_t nRow;
+	unsigned char cState;
+	bool bOk;
+	int i, iKind;
+	int iRecordsChanged = 0;
+	int iChildRecordsChanged = 0;
+	PxDynasetObject* pyChild;
+	Py_ssize_t n, nLen;
+
+	if (self->pyBeforeSaveCB) {
+		PyObject* pyArgs = PyTuple_Pack(1, (PyObject*)self);
+		//Py_INCREF(self);
+		PyObject* pyResult = PyObject_CallObject(self->pyBeforeSaveCB, pyArgs);
+		Py_DECREF(pyArgs);
+		if (pyResult == NULL)
+			return -1;
+		//else if (pyResult == Py_False) {
+		//	Py_DECREF(pyResult);
+		//	return 0;
+		//}
+		else Py_DECREF(pyResult);
+	}
+
+	for (i = 0; i < 3; i++)
+		if ((pnRows[i] = (Py_ssize_t*)PyMem_RawMalloc((self->nDirty ? self->nDirty : 1) * sizeof(Py_ssize_t))) == NULL) {
+			PyErr_NoMemory();
+			goto ERROR;
+		}
+
+	// collect own dirty rows
+	for (n = 0; n < self->nDirty; n++) {
+		nRow = self->pnDirty[n];
+		cState = PxDynaset_GetRowState(self, nRow);
+		if (cState & PxROW_DELETE) {
+			if (cState & PxROW_NEW)
+				continue; // never got to the database
+			iKind = PxSTATEMENT_DELETE;
+		}
+		else if (cState & PxROW_NEW)
+			iKind = PxSTATEMENT_INSERT;
+		else if (cState & PxROW_MODIFIED)
+			iKind = PxSTATEMENT_UPDATE;
+		else
+			continue;
+
+		if (PxDynaset_GetStatement(self, iKind) == NULL)
+			goto ERROR;
+		pnRows[iKind][nRows[iKind]++] = nRow;
+	}
+
+	// send each batch to the database in one go, or bind the rows to a statement prepared once if direct
+	for (i = 0; i < 3; i++) {
+		iKind = iOrder[i];
+		if (nRows[iKind] == 0)
+			continue;
+		pStatement = self->pStatements[iKind];
+
+		if (self->bDirect) {
+			if (!PxDynaset_WriteDirect(self, pStatement, iKind == PxSTATEMENT_INSERT && self->pyAutoColumn, pnRows[iKind], nRows[iKind]))
+				goto ERROR;
+		}
+		else {
+			if ((pyBatch = PxDynaset_ParameterBatch(self, pStatement, pnRows[iKind], nRows[iKind])) == NULL)
+				goto ERROR;
+			if (iKind == PxSTATEMENT_INSERT && self->pyAutoColumn)
+				bOk = PxDynaset_InsertOneByOne(self, pStatement, pyBatch, pnRows[iKind]);
+			else if ((bOk = (pyCursor = PyObject_CallMethod(self->pyConnection, "executemany", "(OO)", pStatement->pySQL, pyBatch)) != NULL))
+				Py_DECREF(pyCursor);
+			Py_XSETREF(self->pyParams, pyBatch);
+			if (!bOk)
+				goto ERROR;
+		}
+		iRecordsChanged += (int)nRows[iKind];
+	}
+
+	for (i = 0; i < 3; i++)
+		PyMem_RawFree(pnRows[i]);
+
+	// write all descendants in the same transaction, a failure anywhere has Save take back the whole tree
+	nLen = PySequence_Size(self->pyChildren);
+	for (n = 0; n < nLen; n++) {
+		pyChild = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
+		if (!PxDynaset_FetchTo(pyChild, -1) || !PxDynaset_FlushChildRefresh(pyChild))
+			return -1;
+		if ((iChildRecordsChanged = PxDynaset_Write(pyChild)) == -1)
+			return -1;
+		iRecordsChanged += iChildRecordsChanged;
+	}
+
+	//g_debug("Saved Dynaset! %d %s", iRecordsChanged, sSql);
+	return iRecordsChanged;
+
+ERROR:
+	for (i = 0; i < 3; i++)
+		PyMem_RawFree(pnRows[i]);
+	return -1;
+}
+
+static bool
+// after sucessful commit remove deleted rows, mark all clean and unfreeze record pointer widgets all through the subtree
+PxDynaset_CleanUp(PxDynasetObject* self)
+{
+	PxDynasetObject* pyChild;
+	Py_ssize_t n, nLen;
+
+	// only rows in the dirty list can need attention, deleted ones are collected and removed together
+	unsigned char cState;
+	Py_ssize_t* pnDeleted, nDeleted = 0, nRow, nCurrent = self->nRow;
+
+	if ((pnDeleted = (Py_ssize_t*)PyMem_RawMalloc((self->nDirty ? self->nDirty : 1) * sizeof(Py_ssize_t))) == NULL) {
+		PyErr_NoMemory();
+		return false;
+	}
+	for (n = 0; n < self->nDirty; n++) {
+		nRow = self->pnDirty[n];
+		cState = PxDynaset_GetRowState(self, nRow);
+
+		// DELETE
+		if (cState & PxROW_DELETE)
+			pnDeleted[nDeleted++] = nRow;
+		// INSERT
+		else if (cState & PxROW_NEW)
+			PxDynaset_SetRowFlag(self, nRow, PxROW_NEW, false);
+		// UPDATE
+		else if (cState & PxROW_MODIFIED)
+			PxDynaset_SetModified(self, nRow, false);
+	}
+	PxDynaset_ForgetJournal(self);
+	if (!PxDynaset_RemoveRows(self, pnDeleted, nDeleted)) {
+		PyMem_RawFree(pnDeleted);
+		return false;
+	}
+	// the row pointer moves up by the deleted rows up to and including its own
+	for (n = 0; n < nDeleted && pnDeleted[n] <= nCurrent; n++)
+		self->nRow--;
+	PyMem_RawFree(pnDeleted);
+	self->nDirty = 0;
+
+	if (self->pyCache)
+		PyDict_Clear(self->pyCache);
+
+	self->bClean = true;
+	self->bFrozen = false;
+	if (self->pyParent == NULL || self->pyParent == Py_None || self->pyParent->bLocked)
+		self->bLocked = true;
+	else
+		self->bLocked = false;
+
+	// clean up all descendants
+	nLen = PySequence_Size(self->pyChildren);
+	for (n = 0; n < nLen; n++) {
+		pyChild = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
+		if (!PxDynaset_CleanUp(pyChild))
+			return false;
+	}
+
+	PxDynaset_RefreshBoundWidgets(self, true, true, true);
+	PxDynaset_UpdateControlWidgets(self);
+	return true;
+}
+
+static bool
+PxDynaset_EmptyRowData(PxDynasetObject* self)
+// construct the row data to prepopulate new rows with, if it has not been done for the current column set
+{
+	PyObject* pyData;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t n;
+
+	if (self->pyEmptyRowData)
+		return true;
+	if ((self->pyEmptyRowData = PyTuple_New(self->nDataColumns)) == NULL)
+		return false;
+	for (n = 0; n < self->nColumnInfo; n++) {
+		pInfo = self->pColumnInfo + n;
+		if (pInfo->nIndex == -1)
+			continue;
+
+		// if it is an auto column, prepopulate with -1
+		if (pInfo->pyColumn == self->pyAutoColumn)
+			pyData = PyLong_FromLong(-1);
+		// if it got a parent column, prepopulate with data of that
+		else if (pInfo->pyParentColumn && self->pyParent)
+			pyData = PxDynaset_GetData(self->pyParent, self->pyParent->nRow, pInfo->pyParentColumn); // new ref
+		else {
+			// if it got a default value, use that
+			pyData = PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_DEFAULT);
+			if (pyData == Py_None) {
+				// if it got a default function, call that to get a data value
+				pyData = PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_DEFFUNC);
+				if (pyData != Py_None)
+					pyData = PyObject_CallObject(pyData, NULL);
+				else
+					Py_INCREF(pyData);
+			}
+			else
+				Py_INCREF(pyData);
+		}
+		if (pyData == NULL) {
+			Py_CLEAR(self->pyEmptyRowData);
+			return false;
+		}
+		PyTuple_SET_ITEM(self->pyEmptyRowData, pInfo->nIndex, pyData);
+	}
+	return true;
+}
+
+bool
+PxDynaset_NewRow(PxDynasetObject* self, Py_ssize_t nRow)
+{
+	PyObject* pyFreshRowData;
+
+	if (self->bColumnar && self->pStore == NULL && !PxDynaset_CreateStore(self, self->nDataColumns))
+		return false;
+	if (!PxDynaset_EmptyRowData(self))
+		return false;
+
+	if ((pyFreshRowData = PyTuple_Duplicate(self->pyEmptyRowData)) == NULL)
+		return false;
+	bool bOk = PxDynaset_InsertRow(self, nRow == -1 ? self->nRows : nRow + 1, pyFreshRowData, PxROW_NEW);
+	Py_DECREF(pyFreshRowData);
+	if (!bOk)
+		return false;
+	if (nRow <= self->nRow)
+		self->nRow++;
+	if (!PxDynaset_DataChanged(self, -1, NULL))
+		return false;
+	return true;
+}
+
+static PyObject*
+PxDynaset_new_row(PxDynasetObject* self, PyObject *args, PyObject *kwds)
+{
+	static char *kwlist[] = { "row", NULL };
+	Py_ssize_t nRow = self->nRow;
+	//if (!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &nRow)) {
+	//	goto ERROR;
+	//}
+	if (nRow == -1)
+		nRow = self->nRows - 1;
+
+	if (!PxDynaset_SetRow(self, -1))
+		goto ERROR;
+	if (!PxDynaset_NewRow(self, nRow))
+		goto ERROR;
+	if (!PxDynaset_SetRow(self, nRow + 1))
+		goto ERROR;
+
+	Py_RETURN_NONE;
+
+ERROR:
+	PythonErrorDialog();
+	return NULL;
+}
+
+// Bulk import
+// Rows are appended as new rows without notifying anyone per row or cell, bound widgets are refreshed once at the end.
+
+#define PxIMPORT_PROGRESS_STEP 5000 // rows between progress messages
+
+static PyObject* // new ref
+PxDynaset_ImportValue(PyObject* pyColumn, PyObject* pyData)
+// text for a numeric column is converted, empty text taken as NULL
+{
+	PyObject* pyType = PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_TYPE);
+
+	if (PyUnicode_Check(pyData) && (pyType == (PyObject*)&PyLong_Type || pyType == (PyObject*)&PyFloat_Type)) {
+		if (PyUnicode_GET_LENGTH(pyData) == 0)
+			Py_RETURN_NONE;
+		return PyObject_CallFunctionObjArgs(pyType, pyData, NULL);
+	}
+	Py_INCREF(pyData);
+	return pyData;
+}
+
+static void
+PxDynaset_DropRowsFrom(PxDynasetObject* self, Py_ssize_t nFirst)
+// take back the rows appended from nFirst on, the exception raised is kept
+{
+	PyObject* pyType, *pyValue, *pyTraceback;
+	Py_ssize_t* pnRows, n;
+
+	PyErr_Fetch(&pyType, &pyValue, &pyTraceback);
+	if ((pnRows = (Py_ssize_t*)PyMem_RawMalloc((self->nRows - nFirst) * sizeof(Py_ssize_t))) != NULL) {
+		for (n = nFirst; n < self->nRows; n++)
+			pnRows[n - nFirst] = n;
+		PxDynaset_RemoveRows(self, pnRows, self->nRows - nFirst);
+		PyMem_RawFree(pnRows);
+	}
+	PyErr_Restore(pyType, pyValue, pyTraceback);
+}
+
+static Py_ssize_t
+PxDynaset_ImportRows(PxDynasetObject* self, PyObject* pyIterator, PyObject* pyMapping)
+// append the rows the iterator yields as new rows, returns their number or -1, in which case none has been appended
+{
+	PyObject* pyKeys = NULL, *pyPositions = NULL, *pyColumns = NULL, *pyRow, *pyRowData, *pyKey, *pyValue, *pyData, *pyColumn;
+	PxDynasetColumnInfo* pInfo;
+	Py_ssize_t n, nColumns, nFirst = self->nRows;
+	char sMessage[40];
+	bool bOk = true;
+
+	// before any query the columns have their positions in the row data from add_column, as the query's are expected in
+	if (self->nDataColumns == 0) {
+		PyErr_SetString(PyExc_RuntimeError, "Importing rows needs columns.");
+		return -1;
+	}
+	if (self->bColumnar && self->pStore == NULL && !PxDynaset_CreateStore(self, self->nDataColumns))
+		return -1;
+	if (!PxDynaset_EmptyRowData(self))
+		return -1;
+
+	// which item of a row goes into which column: by the mapping, else by column name for dicts and by position for sequences
+	if ((pyKeys = PyList_New(0)) == NULL || (pyPositions = PyList_New(0)) == NULL || (pyColumns = PyList_New(0)) == NULL)
+		goto ERROR;
+	if (pyMapping) {
+		if (!PyDict_Check(pyMapping)) {
+			PyErr_SetString(PyExc_TypeError, "Parameter 'mapping' must be a dict.");
+			goto ERROR;
+		}
+		n = 0;
+		while (PyDict_Next(pyMapping, &n, &pyKey, &pyValue)) {
+			if ((pyColumn = PxDynaset_ColumnArgument(self, pyValue)) == NULL || PxDynaset_ColumnIndex(pyColumn) == -1)
+				goto ERROR;
+			if (PyList_Append(pyKeys, pyKey) == -1 || PyList_Append(pyPositions, pyKey) == -1 || PyList_Append(pyColumns, pyColumn) == -1)
+				goto ERROR;
+		}
+	}
+	else {
+		// the auto column is left to the database
+		for (pInfo = self->pColumnInfo; pInfo < self->pColumnInfo + self->nColumnInfo; pInfo++) {
+			if (pInfo->nIndex == -1 || pInfo->pyColumn == self->pyAutoColumn)
+				continue;
+			if ((pyKey = PyLong_FromSsize_t(PyList_GET_SIZE(pyColumns))) == NULL)
+				goto ERROR;
+			n = PyList_Append(pyPositions, pyKey);
+			Py_DECREF(pyKey);
+			if (n == -1 || PyList_Append(pyKeys, PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_NAME)) == -1 ||
+				PyList_Append(pyColumns, pInfo->pyColumn) == -1)
+				goto ERROR;
+		}
+	}
+	nColumns = PyList_GET_SIZE(pyColumns);
+
+	PxDynaset_SetLoading(self, true);
+	while (bOk && (pyRow = PyIter_Next(pyIterator))) {
+		if ((pyRowData = PyTuple_Duplicate(self->pyEmptyRowData)) == NULL) {
+			Py_DECREF(pyRow);
+			bOk = false;
+			break;
+		}
+		for (n = 0; bOk && n < nColumns; n++) {
+			pyColumn = PyList_GET_ITEM(pyColumns, n);
+			pyKey = PyList_GET_ITEM(PyDict_Check(pyRow) ? pyKeys : pyPositions, n);
+			if ((pyValue = PyObject_GetItem(pyRow, pyKey)) == NULL) {
+				if (PyErr_ExceptionMatches(PyExc_LookupError)) // missing, keep the default
+					PyErr_Clear();
+				else
+					bOk = false;
+				continue;
+			}
+			pyData = PxDynaset_ImportValue(pyColumn, pyValue);
+			Py_DECREF(pyValue);
+			if (pyData == NULL) {
+				bOk = false;
+				break;
+			}
+			PyTuple_SetItem(pyRowData, PyLong_AsSsize_t(PyStructSequence_GET_ITEM(pyColumn, PXDYNASETCOLUMN_INDEX)), pyData);
+		}
+		Py_DECREF(pyRow);
+		if (bOk)
+			bOk = PxDynaset_InsertRow(self, self->nRows, pyRowData, PxROW_NEW);
+		Py_DECREF(pyRowData);
+
+		// the message only, running the main loop here would let callbacks act on the half imported rows
+		if (bOk && (self->nRows - nFirst) % PxIMPORT_PROGRESS_STEP == 0) {
+			sprintf(sMessage, "Rows imported: %zd", self->nRows - nFirst);
+			gtk_statusbar_pop(g.gtkStatusbar, 1);
+			gtk_statusbar_push(g.gtkStatusbar, 1, sMessage);
+		}
+	}
+	PxDynaset_SetLoading(self, false);
+	if (!bOk || PyErr_Occurred())
+		goto ERROR;
+	Py_DECREF(pyKeys);
+	Py_DECREF(pyPositions);
+	Py_DECREF(pyColumns);
+
+	sprintf(sMessage, "Rows imported: %zd", self->nRows - nFirst);
+	gtk_statusbar_pop(g.gtkStatusbar, 1);
+	gtk_statusbar_push(g.gtkStatusbar, 1, sMessage);
+	if (!PxDynaset_Stain(self) || !PxDynaset_DataChanged(self, -1, NULL))
+		return -1;
+	return self->nRows - nFirst;
+
+ERROR:
+	Py_XDECREF(pyKeys);
+	Py_XDECREF(pyPositions);
+	Py_XDECREF(pyColumns);
+	if (self->nRows > nFirst)
+		PxDynaset_DropRowsFrom(self, nFirst);
+	return -1;
+}
+
+static PyObject* // new ref
+PxDynaset_import_rows(PxDynasetObject* self, PyObject* args, PyObject* kwds)
+{
+	static char *kwlist[] = { "source", "mapping", "save", NULL };
+	PyObject* pySource, *pyMapping = NULL, *pyModule, *pyFile = NULL, *pyIterator = NULL, *pyResult;
+	PyObject* pyType, *pyValue, *pyTraceback;
+	Py_ssize_t nRows = -1;
+	int bSave = false;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Op", kwlist, &pySource, &pyMapping, &bSave))
+		return NULL;
+	if (pyMapping == Py_None)
+		pyMapping = NULL;
+
+	// a path names a CSV file whose first line holds the field names
+	if (PyUnicode_Check(pySource) || PyObject_HasAttrString(pySource, "__fspath__")) {
+		if ((pyModule = PyImport_ImportModule("io")) == NULL)
+			return NULL;
+		pyFile = PyObject_CallMethod(pyModule, "open", "(Osisss)", pySource, "r", -1, "utf-8-sig", NULL, "");
+		Py_DECREF(pyModule);
+		if (pyFile == NULL)
+			return NULL;
+		if ((pyModule = PyImport_ImportModule("csv")) != NULL) {
+			pyIterator = PyObject_CallMethod(pyModule, "DictReader", "(O)", pyFile);
+			Py_DECREF(pyModule);
+		}
+	}
+	else
+		pyIterator = PyObject_GetIter(pySource);
+
+	if (pyIterator)
+		nRows = PxDynaset_ImportRows(self, pyIterator, pyMapping);
+	Py_XDECREF(pyIterator);
+	if (pyFile) {
+		PyErr_Fetch(&pyType, &pyValue, &pyTraceback);
+		pyResult = PyObject_CallMethod(pyFile, "close", NULL);
+		Py_XDECREF(pyResult);
+		Py_DECREF(pyFile);
+		if (pyType)
+			PyErr_Restore(pyType, pyValue, pyTraceback);
+		else if (pyResult == NULL)
+			nRows = -1;
+	}
+	if (nRows == -1)
+		return NULL;
+
+	if (bSave && !PxDynaset_Save(self))
+		return NULL;
+	return PyLong_FromSsize_t(nRows);
+}
+
+// Export
+// Rows are written as CSV or JSON Lines through a buffered file one at a time, so memory use does not grow with the number of rows.
+// Native columns of a columnar Dynaset are written straight from their vectors.
 
-			Py_DECREF(pyCursor);
+#define PxEXPORT_CSV    0
+#define PxEXPORT_JSONL  1
 
-			if (self->sUpdateSQL)
-				PyMem_RawFree(self->sUpdateSQL);
-			self->sUpdateSQL = sSql;
-			PyMem_RawFree(sSql2);
+typedef struct _PxExportColumn
+{
+	PyObject* pyName;     // borrowed
+	Py_ssize_t nIndex;    // position in the row data or in the rows of the query
+	PyObject* pyFormat;   // borrowed, NULL to write values as they are
+}
+PxExportColumn;
+
+static void
+PxDynaset_ExportText(FILE* pFile, int iFormat, const char* sText, Py_ssize_t nLength)
+// CSV fields are quoted if they contain a separator, a quote or a line break; JSON strings are always quoted
+{
+	const char* s, *sEnd = sText + nLength;
 
-			Py_XDECREF(self->pyParams);
-			self->pyParams = pyParams;
-			Py_DECREF(pyRowDataOld);
+	if (iFormat == PxEXPORT_CSV) {
+		for (s = sText; s < sEnd && *s != ',' && *s != '"' && *s != '\n' && *s != '\r'; s++);
+		if (s == sEnd) {
+			fwrite(sText, 1, nLength, pFile);
+			return;
+		}
+		putc('"', pFile);
+		for (s = sText; s < sEnd; s++) {
+			if (*s == '"')
+				putc('"', pFile);
+			putc(*s, pFile);
 		}
-		Py_XDECREF(pyParams);
+		putc('"', pFile);
+		return;
 	}
 
-	// save all descendants
-	nLen = PySequence_Size(self->pyChildren);
-	for (n = 0; n < nLen; n++) {
-		pyChild = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
-		iChildRecordsChanged = PxDynaset_Save(pyChild);
-		if (iChildRecordsChanged == -1)
-			return -1;
-		else
-			iRecordsChanged += iChildRecordsChanged;
+	putc('"', pFile);
+	for (s = sText; s < sEnd; s++) {
+		switch (*s) {
+		case '"': fputs("\\\"", pFile); break;
+		case '\\': fputs("\\\\", pFile); break;
+		case '\n': fputs("\\n", pFile); break;
+		case '\r': fputs("\\r", pFile); break;
+		case '\t': fputs("\\t", pFile); break;
+		default:
+			if ((unsigned char)*s < 0x20)
+				fprintf(pFile, "\\u%04x", (unsigned char)*s);
+			else
+				putc(*s, pFile);
+		}
 	}
-
-	//g_debug("Saved Dynaset! %d %s", iRecordsChanged, sSql);
-	return iRecordsChanged;
+	putc('"', pFile);
 }
 
-static bool
-// after sucessful commit remove deleted rows, mark all clean and unfreeze record pointer widgets all through the subtree
-PxDynaset_CleanUp(PxDynasetObject* self)
+static void
+PxDynaset_ExportReal(FILE* pFile, int iFormat, double fData)
+// as str() would give it, NaN and infinity are null in JSON
 {
-	PxDynasetObject* pyChild;
-	Py_ssize_t n, nLen;
+	char* sText;
 
-	// iterate over own rows
-	PyObject* pyRow, *pyRowDataOld, *pyRowDelete, *pyRowNew, *tmp;
-	Py_ssize_t nRow, nColumn, nPos;
-
-	nLen = PySequence_Size(self->pyRows);
-	for (nRow = 0; nRow < nLen; nRow++) {
-		pyRow = PyList_GetItem(self->pyRows, nRow);
-		pyRowDataOld = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATAOLD);
-		pyRowDelete = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DELETE);
-		pyRowNew = PyStructSequence_GetItem(pyRow, PXDYNASETROW_NEW);
+	if (iFormat == PxEXPORT_JSONL && !isfinite(fData)) {
+		fputs("null", pFile);
+		return;
+	}
+	if ((sText = PyOS_double_to_string(fData, 'r', 0, Py_DTSF_ADD_DOT_0, NULL)) == NULL) {
+		PyErr_Clear();
+		fprintf(pFile, "%.17g", fData);
+		return;
+	}
+	fputs(sText, pFile);
+	PyMem_Free(sText);
+}
 
-		// DELETE
-		if (pyRowDelete == Py_True) {
-			if (PyList_SetSlice(self->pyRows, nRow, nRow + 1, NULL) == -1)
-				return -1;
+static bool
+PxDynaset_ExportValue(FILE* pFile, int iFormat, PxExportColumn* pColumn, PyObject* pyData)
+{
+	PyObject* pyText;
+	const char* sText;
+	Py_ssize_t nLength;
 
-			if (nRow <= self->nRow)
-				self->nRow--;
-			self->nRows--;
-			nLen--;
-			nRow--; // the row pointed to has just been deleted, the next one will have to have the same index
-		}
-		// INSERT
-		else if (pyRowNew == Py_True) {
-			Py_INCREF(Py_False);
-			PyStructSequence_SetItem(pyRow, PXDYNASETROW_NEW, Py_False);
-		}
-		// UPDATE
-		else if (pyRowDataOld != Py_None) {
-			Py_DECREF(pyRowDataOld);
-			Py_INCREF(Py_None);
-			PyStructSequence_SetItem(pyRow, PXDYNASETROW_DATAOLD, Py_None);
-		}
+	if (pyData == Py_None) {
+		if (iFormat == PxEXPORT_JSONL)
+			fputs("null", pFile);
+		return true;
 	}
 
-	self->bClean = true;
-	self->bFrozen = false;
-	if (self->pyParent == NULL || self->pyParent == Py_None || self->pyParent->bLocked)
-		self->bLocked = true;
-	else
-		self->bLocked = false;
-
-	// clean up all descendants
-	nLen = PySequence_Size(self->pyChildren);
-	for (n = 0; n < nLen; n++) {
-		pyChild = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
-		if (!PxDynaset_CleanUp(pyChild))
+	if (PyBool_Check(pyData)) {
+		if (iFormat == PxEXPORT_JSONL)
+			fputs(pyData == Py_True ? "true" : "false", pFile);
+		else
+			fputs(pyData == Py_True ? "True" : "False", pFile);
+		return true;
+	}
+	// numbers and dates get their display format like in a table
+	else if (pColumn->pyFormat && (PyLong_Check(pyData) || PyFloat_Check(pyData)))
+		pyText = PyObject_CallMethod(pColumn->pyFormat, "format", "(O)", pyData);
+	else if (PyLong_Check(pyData)) {
+		if ((pyText = PyObject_Str(pyData)) == NULL)
 			return false;
+		fputs(PyUnicode_AsUTF8(pyText), pFile); // digits only, nothing to quote
+		Py_DECREF(pyText);
+		return true;
+	}
+	else if (PyFloat_Check(pyData)) {
+		PxDynaset_ExportReal(pFile, iFormat, PyFloat_AS_DOUBLE(pyData));
+		return true;
+	}
+	else if (PyUnicode_Check(pyData)) {
+		pyText = pyData;
+		Py_INCREF(pyText);
 	}
+	else if (PyObject_HasAttrString(pyData, "strftime"))
+		pyText = PyObject_CallMethod(pColumn->pyFormat ? pColumn->pyFormat : g.pyStdDateTimeFormat, "format", "(O)", pyData);
+	else
+		pyText = PyObject_Str(pyData);
+	if (pyText == NULL)
+		return false;
 
-	PxDynaset_RefreshBoundWidgets(self, true, true, true);
-	PxDynaset_UpdateControlWidgets(self);
+	if ((sText = PyUnicode_AsUTF8AndSize(pyText, &nLength)) == NULL) {
+		Py_DECREF(pyText);
+		return false;
+	}
+	PxDynaset_ExportText(pFile, iFormat, sText, nLength);
+	Py_DECREF(pyText);
 	return true;
 }
 
-bool
-PxDynaset_NewRow(PxDynasetObject* self, Py_ssize_t nRow)
+static bool
+PxDynaset_ExportNative(PxDynasetObject* self, FILE* pFile, int iFormat, PxExportColumn* pColumn, Py_ssize_t nRow)
+// write a cell of a native column from its vector, false if it has to go through a Python object
 {
-	PyObject* pyColumnName, *pyColumn, *pyRow, *pyRowData, *pyFreshRowData, *pyData, *pyIndex;
-	Py_ssize_t nPos = 0, nCol = 0, nAutoCol = -1;
+	PxColumnVector* pVector;
+	PxTextRef* pText;
 
-	if (self->pyEmptyRowData == NULL) {
-		self->pyEmptyRowData = PyTuple_New(PyDict_Size(self->pyColumns));//PyList_New(0);
+	if (self->pStore == NULL || pColumn->pyFormat)
+		return false;
+	pVector = self->pStore->pColumns + pColumn->nIndex;
+	if (pVector->iKind == PxCOLUMN_OBJECT)
+		return false;
 
-		// determine the index# of the auto column, if any
-		if (self->pyAutoColumn) {
-			pyColumn = PyStructSequence_GetItem(self->pyAutoColumn, PXDYNASETCOLUMN_INDEX);
-			if (pyColumn == Py_None) { // query has not been run yet
-				nAutoCol = 0;
-				PyStructSequence_SetItem(pyColumn, PXDYNASETCOLUMN_INDEX, PyLong_FromSsize_t(0));
-			}
-			else
-				nAutoCol = PyLong_AsSsize_t(pyColumn);
-		}
+	if (!pVector->pValid[nRow]) {
+		if (iFormat == PxEXPORT_JSONL)
+			fputs("null", pFile);
+	}
+	else if (pVector->iKind == PxCOLUMN_INTEGER)
+		fprintf(pFile, "%lld", pVector->piData[nRow]);
+	else if (pVector->iKind == PxCOLUMN_REAL)
+		PxDynaset_ExportReal(pFile, iFormat, pVector->pfData[nRow]);
+	else {
+		pText = pVector->pText + nRow;
+		PxDynaset_ExportText(pFile, iFormat, pVector->sArena + pText->nOffset, (Py_ssize_t)pText->nLength);
+	}
+	return true;
+}
 
-		// construct a list of row data to prepopulate the new row
-		while (PyDict_Next(self->pyColumns, &nPos, &pyColumnName, &pyColumn)) {
-			if (PyErr_Occurred()) {
+static bool
+PxDynaset_ExportRow(PxDynasetObject* self, FILE* pFile, int iFormat, PxExportColumn* pColumns, Py_ssize_t nColumns, PyObject* pyRow, Py_ssize_t nRow)
+// a row of the query if pyRow is given, else the loaded row nRow
+{
+	PyObject* pyData;
+	const char* sName;
+	Py_ssize_t n, nLength;
+	bool bOk;
+
+	if (iFormat == PxEXPORT_JSONL)
+		putc('{', pFile);
+	for (n = 0; n < nColumns; n++) {
+		if (n > 0)
+			putc(',', pFile);
+		if (iFormat == PxEXPORT_JSONL) {
+			if ((sName = PyUnicode_AsUTF8AndSize(pColumns[n].pyName, &nLength)) == NULL)
 				return false;
-			}
-			nCol = PyLong_AsSsize_t(PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX));
-
-			// if it is an auto column, prepopulate with -1
-			if (nCol == nAutoCol)
-				pyData = PyLong_FromLong(-1);
-			else {
-				// if it got a parent column, prepopulate with data of that
-				pyData = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_PARENT);
-				if (pyData != Py_None && self->pyParent) {
-					pyData = PxDynaset_GetData(self->pyParent, self->pyParent->nRow, pyData);
-					if (pyData == NULL) {
-						return false;
-					}
-					//Xx("Parent data", pyData);
-				}
-				else {
-					// if it got a default value, use that
-					pyData = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_DEFAULT);
-					if (pyData == Py_None) {
-						// if it got a default function, call that to get a data value
-						pyData = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_DEFFUNC);
-						if (pyData != Py_None) {
-							if (!(pyData = PyObject_CallObject(pyData, NULL)))
-								return false;
-						}
-					}
-					Py_INCREF(pyData);
-				}
-			}
-			PyTuple_SET_ITEM(self->pyEmptyRowData, nCol, pyData);
-			//PyList_Append(pyRowData, Py_None);
-			//pyIndex = PyStructSequence_GetItem(pyColumn, PXDYNASETCOLUMN_INDEX);
-			//if (pyIndex == Py_None)
-			//	PyStructSequence_SetItem(pyColumn, PXDYNASETCOLUMN_INDEX, PyLong_FromSsize_t(nCol));
-			//nCol++;
+			PxDynaset_ExportText(pFile, iFormat, sName, nLength);
+			putc(':', pFile);
 		}
+		if (pyRow == NULL && PxDynaset_ExportNative(self, pFile, iFormat, pColumns + n, nRow))
+			continue;
+		if ((pyData = pyRow ? PySequence_GetItem(pyRow, pColumns[n].nIndex) : PxDynaset_GetCell(self, nRow, pColumns[n].nIndex)) == NULL)
+			return false;
+		bOk = PxDynaset_ExportValue(pFile, iFormat, pColumns + n, pyData);
+		Py_DECREF(pyData);
+		if (!bOk)
+			return false;
 	}
-
-	pyFreshRowData = PyTuple_Duplicate(self->pyEmptyRowData);
-	pyRow = PyStructSequence_New(&PxDynasetRowType);
-	Py_INCREF(Py_None);
-	Py_INCREF(Py_True);
-	Py_INCREF(Py_False);
-	PyStructSequence_SetItem(pyRow, PXDYNASETROW_DATA, pyFreshRowData);
-	PyStructSequence_SetItem(pyRow, PXDYNASETROW_DATAOLD, Py_None);
-	PyStructSequence_SetItem(pyRow, PXDYNASETROW_NEW, Py_True);
-	PyStructSequence_SetItem(pyRow, PXDYNASETROW_DELETE, Py_False);
-
-	int iResult;
-	if (nRow == -1)
-		iResult = PyList_Append(self->pyRows, pyRow);
-	else
-		iResult = PyList_Insert(self->pyRows, nRow + 1, pyRow);
-
-	if (iResult == -1) {
-		//PyErr_SetString(PyExc_RuntimeError, "Can not add row to Dynaset.");
-		Py_DECREF(pyFreshRowData);
-		return false;
-	}
-	//Py_DECREF(pyItem);
-	self->nRows++;
-	if (nRow <= self->nRow)
-		self->nRow++;
-	if (!PxDynaset_DataChanged(self, -1, NULL))
-		return false;
+	fputs(iFormat == PxEXPORT_JSONL ? "}\n" : "\r\n", pFile);
 	return true;
 }
 
-static PyObject*
-PxDynaset_new_row(PxDynasetObject* self, PyObject *args, PyObject *kwds)
+static PyObject* // new ref
+PxDynaset_export(PxDynasetObject* self, PyObject* args, PyObject* kwds)
 {
-	static char *kwlist[] = { "row", NULL };
-	Py_ssize_t nRow = self->nRow;
-	//if (!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &nRow)) {
-	//	goto ERROR;
-	//}
-	if (nRow == -1)
-		nRow = self->nRows - 1;
+	static char *kwlist[] = { "path", "format", "columns", "formats", "query", NULL };
+	PyObject* pyPath, *pyColumnList = NULL, *pyFormats = NULL, *pyBytes = NULL, *pyCursor = NULL, *pyRows = NULL, *pyDescription, *pyItem, *pyColumn, *pyFormat;
+	PxExportColumn* pColumns = NULL;
+	PxDynasetColumnInfo* pInfo;
+	const char* sFormat = "csv", *sName;
+	Py_ssize_t n, m, nColumns = 0, nRow, nWritten = 0;
+	int iFormat, bQuery = false;
+	FILE* pFile = NULL;
+	bool bOk = false, bAll;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sOOp", kwlist, &pyPath, &sFormat, &pyColumnList, &pyFormats, &bQuery))
+		return NULL;
+	if (strcmp(sFormat, "csv") == 0)
+		iFormat = PxEXPORT_CSV;
+	else if (strcmp(sFormat, "jsonl") == 0)
+		iFormat = PxEXPORT_JSONL;
+	else {
+		PyErr_SetString(PyExc_ValueError, "Parameter 'format' must be 'csv' or 'jsonl'.");
+		return NULL;
+	}
+	if (pyFormats == Py_None)
+		pyFormats = NULL;
+	if (pyFormats && !PyDict_Check(pyFormats)) {
+		PyErr_SetString(PyExc_TypeError, "Parameter 'formats' must be a dict.");
+		return NULL;
+	}
+	if (pyColumnList == Py_None)
+		pyColumnList = NULL;
+	if (pyColumnList && (pyColumnList = PySequence_Fast(pyColumnList, "Parameter 'columns' must be a sequence.")) == NULL)
+		return NULL;
+	if (!bQuery && !PxDynaset_FetchAll(self, "export them, pass query=True"))
+		goto ERROR;
 
-	if (!PxDynaset_SetRow(self, -1))
+	// the columns to write, if not given those of the query in the order they have been added, all before the first execute
+	bAll = pyColumnList == NULL && bQuery && self->nDataColumns == 0;
+	if ((pColumns = (PxExportColumn*)PyMem_RawMalloc((pyColumnList ? PySequence_Fast_GET_SIZE(pyColumnList) : self->nColumnInfo) * sizeof(PxExportColumn) + 1)) == NULL) {
+		PyErr_NoMemory();
 		goto ERROR;
-	if (!PxDynaset_NewRow(self, nRow))
+	}
+	for (n = 0; n < (pyColumnList ? PySequence_Fast_GET_SIZE(pyColumnList) : self->nColumnInfo); n++) {
+		if (pyColumnList) {
+			if ((pyColumn = PxDynaset_ColumnArgument(self, PySequence_Fast_GET_ITEM(pyColumnList, n))) == NULL)
+				goto ERROR;
+			pInfo = PxDynaset_FindColumn(self, pyColumn);
+		}
+		else if ((pInfo = self->pColumnInfo + n)->nIndex == -1 && !bAll)
+			continue;
+		if (!bQuery && pInfo->nIndex == -1) {
+			PxDynaset_ColumnIndex(pInfo->pyColumn); // raises
+			goto ERROR;
+		}
+		pColumns[nColumns].pyName = PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_NAME);
+		pColumns[nColumns].nIndex = pInfo->nIndex;
+		// formats given win over the columns' display formats, which only apply to CSV
+		pyFormat = pyFormats ? PyDict_GetItem(pyFormats, pColumns[nColumns].pyName) : NULL;
+		if (pyFormat == NULL && iFormat == PxEXPORT_CSV)
+			pyFormat = PyStructSequence_GET_ITEM(pInfo->pyColumn, PXDYNASETCOLUMN_FORMAT);
+		pColumns[nColumns++].pyFormat = pyFormat == Py_None ? NULL : pyFormat;
+	}
+
+	// the query's own rows are read in windows of fetchSize, their columns found by name
+	if (bQuery) {
+		if (self->pyQuery == NULL) {
+			PyErr_SetString(PyExc_RuntimeError, "Dynaset has no query.");
+			goto ERROR;
+		}
+		if ((pyCursor = PyObject_CallMethod(self->pyConnection, "cursor", NULL)) == NULL)
+			goto ERROR;
+		if (self->pyParameters)
+			pyItem = PyObject_CallMethod(pyCursor, "execute", "(OO)", self->pyQuery, self->pyParameters);
+		else
+			pyItem = PyObject_CallMethod(pyCursor, "execute", "(O)", self->pyQuery);
+		if (pyItem == NULL)
+			goto ERROR;
+		Py_DECREF(pyItem);
+		if ((pyDescription = PyObject_GetAttrString(pyCursor, "description")) == NULL)
+			goto ERROR;
+		for (n = 0; n < nColumns; n++) {
+			pColumns[n].nIndex = -1;
+			for (m = 0; m < PySequence_Size(pyDescription); m++) {
+				pyItem = PySequence_GetItem(pyDescription, m);
+				if (pyItem && PyUnicode_Compare(PyTuple_GetItem(pyItem, 0), pColumns[n].pyName) == 0)
+					pColumns[n].nIndex = m;
+				Py_XDECREF(pyItem);
+			}
+			if (pColumns[n].nIndex == -1) {
+				PyErr_Format(PyExc_AttributeError, "Column '%s' is not part of the query.", PyUnicode_AsUTF8(pColumns[n].pyName));
+				Py_DECREF(pyDescription);
+				goto ERROR;
+			}
+		}
+		Py_DECREF(pyDescription);
+	}
+
+	if (!PyUnicode_FSConverter(pyPath, &pyBytes))
 		goto ERROR;
-	if (!PxDynaset_SetRow(self, nRow + 1))
+	if ((pFile = fopen(PyBytes_AS_STRING(pyBytes), "wb")) == NULL) {
+		PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, pyPath);
 		goto ERROR;
+	}
+	setvbuf(pFile, NULL, _IOFBF, 1 << 16);
+
+	if (iFormat == PxEXPORT_CSV) {
+		for (n = 0; n < nColumns; n++) {
+			if (n > 0)
+				putc(',', pFile);
+			if ((sName = PyUnicode_AsUTF8AndSize(pColumns[n].pyName, &m)) == NULL)
+				goto ERROR;
+			PxDynaset_ExportText(pFile, iFormat, sName, m);
+		}
+		fputs("\r\n", pFile);
+	}
 
-	Py_RETURN_NONE;
+	if (bQuery) {
+		while (true) {
+			if ((pyRows = PyObject_CallMethod(pyCursor, "fetchmany", "n", self->nFetchSize > 0 ? self->nFetchSize : 1000)) == NULL)
+				goto ERROR;
+			if (PyList_GET_SIZE(pyRows) == 0)
+				break;
+			for (n = 0; n < PyList_GET_SIZE(pyRows); n++, nWritten++)
+				if (!PxDynaset_ExportRow(self, pFile, iFormat, pColumns, nColumns, PyList_GET_ITEM(pyRows, n), -1))
+					goto ERROR;
+			Py_CLEAR(pyRows);
+		}
+	}
+	else {
+		for (n = 0; n < PxDynaset_ViewRows(self); n++, nWritten++) {
+			nRow = PxDynaset_ViewRow(self, n);
+			if (!PxDynaset_ExportRow(self, pFile, iFormat, pColumns, nColumns, NULL, nRow))
+				goto ERROR;
+		}
+	}
+	if (ferror(pFile)) {
+		PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, pyPath);
+		goto ERROR;
+	}
+	bOk = true;
 
 ERROR:
-	PythonErrorDialog();
-	return NULL;
+	if (pFile && fclose(pFile) != 0 && bOk) {
+		PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, pyPath);
+		bOk = false;
+	}
+	if (pyCursor && bOk) {
+		if ((pyItem = PyObject_CallMethod(pyCursor, "close", NULL)) == NULL)
+			bOk = false;
+		Py_XDECREF(pyItem);
+	}
+	Py_XDECREF(pyCursor);
+	Py_XDECREF(pyRows);
+	Py_XDECREF(pyBytes);
+	Py_XDECREF(pyColumnList);
+	PyMem_RawFree(pColumns);
+	if (!bOk)
+		return NULL;
+	return PyLong_FromSsize_t(nWritten);
 }
 
 bool
 PxDynaset_Undo(PxDynasetObject* self, Py_ssize_t nRow)
 {
-	PyObject* pyRowDataOld;
-	PyObject* pyRow = PyList_GetItem(self->pyRows, nRow);
-
-	if ((pyRowDataOld = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATAOLD)) != Py_None) { // old data
-        PyObject* pyRowData = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATA);
-        Py_DECREF(pyRowData);
-        PyStructSequence_SetItem(pyRow, PXDYNASETROW_DATA, pyRowDataOld);
-        PyStructSequence_SetItem(pyRow, PXDYNASETROW_DATAOLD, Py_None);
+	if (PxDynaset_GetRowState(self, nRow) & PxROW_MODIFIED) { // old data
+        if (!PxDynaset_RevertRow(self, nRow))
+            return false;
         if (!PxDynaset_DataChanged(self, nRow, NULL))
             return false;
 	}
@@ -1183,13 +5968,10 @@ PxDynaset_Undo(PxDynasetObject* self, Py_ssize_t nRow)
 bool
 PxDynaset_DeleteRow(PxDynasetObject* self, Py_ssize_t nRow)
 {
-	PyObject* pyRow = PyList_GetItem(self->pyRows, nRow);
-	PyObject* pyDelete = PyStructSequence_GetItem(pyRow, PXDYNASETROW_DELETE);
-	if (pyDelete == Py_True)
+	if (PxDynaset_GetRowState(self, nRow) & PxROW_DELETE)
 		return true;
-	Py_DECREF(pyDelete);
-	PyStructSequence_SetItem(pyRow, PXDYNASETROW_DELETE, Py_True);
-	Py_INCREF(Py_True);
+	if (!PxDynaset_SetRowFlag(self, nRow, PxROW_DELETE, true))
+		return false;
 	if (!PxDynaset_DataChanged(self, nRow, NULL))
 		return false;
 	return PxDynaset_Stain(self);
@@ -1235,8 +6017,8 @@ PxDynaset_Edit(PxDynasetObject* self)
 		else if (pyBoundWidget->pyDataColumn) {
 			bSensitive = !self->bReadOnly && !pyBoundWidget->bReadOnly /*&& !self->bLocked*/;
 			// readonly if widget is bound to auto column unless row is new
-			if (self->pyAutoColumn == PyStructSequence_GET_ITEM(pyBoundWidget->pyDataColumn, PXDYNASETCOLUMN_INDEX) &&
-				PyStructSequence_GET_ITEM(PyList_GetItem(self->pyRows, self->nRow), PXDYNASETROW_NEW) == Py_False)
+			if (self->pyAutoColumn == pyBoundWidget->pyDataColumn && self->nRow != -1 &&
+				!(PxDynaset_GetRowState(self, self->nRow) & PxROW_NEW))
 				bSensitive = FALSE;
 			// readonly if widget is bound to column which has a parent
 			if (PyStructSequence_GET_ITEM(pyBoundWidget->pyDataColumn, PXDYNASETCOLUMN_PARENT) != Py_None)
@@ -1266,7 +6048,7 @@ PxDynaset_edit(PxDynasetObject* self, PyObject *args)
 static PyObject*
 PxDynaset_save(PxDynasetObject* self, PyObject *args)
 {
-	if (PxDynaset_Save(self) == -1) {
+	if (!PxDynaset_Save(self)) {
 		PythonErrorDialog();
 		return NULL;
 	}
@@ -1286,6 +6068,24 @@ PxDynaset_undo(PxDynasetObject* self, PyObject *args)
 	return NULL;
 }
 
+static PyObject*
+PxDynaset_undo_edit(PxDynasetObject* self, PyObject *args)
+{
+	int iResult = PxDynaset_Replay(self, false);
+	if (iResult == -1)
+		return NULL;
+	return PyBool_FromLong(iResult);
+}
+
+static PyObject*
+PxDynaset_redo_edit(PxDynasetObject* self, PyObject *args)
+{
+	int iResult = PxDynaset_Replay(self, true);
+	if (iResult == -1)
+		return NULL;
+	return PyBool_FromLong(iResult);
+}
+
 static PyObject*
 PxDynaset_delete(PxDynasetObject* self, PyObject *args)
 {
@@ -1372,7 +6172,7 @@ PxDynaset_UnStain(PxDynasetObject* self)
 	Py_ssize_t n, nLen;
 	PxDynasetObject* pyChild;
 
-	self->bClean = true;
+	self->bClean = !PxDynaset_HasDirtyRows(self);
 	// check if any child is stained
 	nLen = PySequence_Size(self->pyChildren);
 	for (n = 0; n < nLen; n++) {
@@ -1428,6 +6228,10 @@ PxDynaset_DataChanged(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn
 	PyObject* pyResult = NULL;
 	PxWidgetObject* pyDependent;
 
+	// computed cells of the row first, so the widgets refreshed below show them up to date
+	if (self->nComputed && nRow != -1 && !PxDynaset_Compute(self, nRow, pyColumn, pyColumn != NULL))
+		return false;
+
 	Py_ssize_t n, nLen = PySequence_Size(self->pyWidgets);
 	for (n = 0; n < nLen; n++) {
 		pyDependent = (PxWidgetObject*)PyList_GetItem(self->pyWidgets, n);
@@ -1451,7 +6255,7 @@ PxDynaset_DataChanged(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn
 	}
 
 	if (self->pyOnChangedCB) {
-		PyObject* pyArgs = Py_BuildValue("(OiO)", (PyObject*)self, nRow,pyColumn);
+		PyObject* pyArgs = Py_BuildValue("(OiO)", (PyObject*)self, nRow, pyColumn ? pyColumn : Py_None);
 		pyResult = PyObject_CallObject(self->pyOnChangedCB, pyArgs);
 		Py_XDECREF(pyArgs);
 		if (pyResult == NULL)
@@ -1463,17 +6267,73 @@ PxDynaset_DataChanged(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn
 	return true;
 }
 
-bool
-PxDynaset_SetRow(PxDynasetObject* self, Py_ssize_t nRow)
+static bool
+PxDynaset_RefreshChildren(PxDynasetObject* self)
+// let the child Dynasets follow the row pointer
+{
+	PxDynasetObject* pyDependent;
+	Py_ssize_t n, nLen;
+
+	nLen = PySequence_Size(self->pyChildren);
+	for (n = 0; n < nLen; n++) {
+		pyDependent = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
+		if (pyDependent->bLoading && pyDependent->pQuery == NULL)
+			PxDynaset_SetLoading(pyDependent, false);
+		if (!PxDynaset_ParentSelectionChanged(pyDependent))
+			return false;
+	}
+	return true;
+}
+
+static gboolean
+PxDynaset_ChildRefreshCB(gpointer gUserData)
+{
+	PxDynasetObject* self = (PxDynasetObject*)gUserData;
+	self->iChildRefreshSourceID = 0;
+	if (!PxDynaset_RefreshChildren(self))
+		PythonErrorDialog();
+	Py_DECREF(self);
+	return G_SOURCE_REMOVE;
+}
+
+static bool
+PxDynaset_FlushChildRefresh(PxDynasetObject* self)
+// refresh the children now if it is still pending
+{
+	bool bOk;
+
+	if (self->iChildRefreshSourceID == 0)
+		return true;
+	g_source_remove(self->iChildRefreshSourceID);
+	self->iChildRefreshSourceID = 0;
+	bOk = PxDynaset_RefreshChildren(self);
+	Py_DECREF(self);
+	return bOk;
+}
+
+static bool
+PxDynaset_MoveRow(PxDynasetObject* self, Py_ssize_t nRow, bool bForce)
+// point to row nRow and notify widgets and children, with bForce even if the pointer is there already but its row has been replaced
 {
 	PxDynasetObject* pyDependent;
 	PyObject* pyResult;
 	Py_ssize_t n, nLen;
 
-	if (self->nRow == nRow)
+	if (self->nRow == nRow && !bForce)
 		return true;
 
-	if (nRow < -1 || nRow > self->nRows) {
+	if (!self->bFetchComplete) {
+		if (nRow >= self->nRows) {
+			if (!PxDynaset_FetchTo(self, nRow))
+				return false;
+		}
+		else if (nRow + self->nFetchSize / 2 >= self->nRows)
+			PxDynaset_RequestFetch(self); // getting close to the end of the loaded rows
+	}
+	if (self->bPaged && nRow != -1 && nRow < self->nFetchSize / 2)
+		PxDynaset_RequestPreviousPage(self);
+
+	if (nRow < -1 || nRow >= self->nRows) {
 		PyErr_Format(PyExc_IndexError, "Cannot set row in Dynaset '%s'. Row number %d out of range (%d).", PyUnicode_AsUTF8(self->pyTable), nRow, self->nRows);
 		return false;
 	}
@@ -1485,14 +6345,28 @@ PxDynaset_SetRow(PxDynasetObject* self, Py_ssize_t nRow)
 
 	PxDynaset_UpdateControlWidgets(self);
 
-	// notify child Dynasets
+	// notify child Dynasets, only once the row pointer has come to rest if a delay is set
 	nLen = PySequence_Size(self->pyChildren);
-	for (n = 0; n < nLen; n++) {
-		pyDependent = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
-		if (!PxDynaset_ParentSelectionChanged(pyDependent))
-			return false;
+	if (self->iChildRefreshDelay > 0 && nLen > 0) {
+		if (self->iChildRefreshSourceID)
+			g_source_remove(self->iChildRefreshSourceID);
+		else {
+			Py_INCREF(self); // released by the timeout callback
+			for (n = 0; n < nLen; n++) {
+				pyDependent = (PxDynasetObject*)PyList_GetItem(self->pyChildren, n);
+				PxDynaset_SetLoading(pyDependent, true); // their rows belong to the previous parent row
+			}
+		}
+		self->iChildRefreshSourceID = g_timeout_add(self->iChildRefreshDelay, PxDynaset_ChildRefreshCB, self);
+		return true;
 	}
-	return true;
+	return PxDynaset_RefreshChildren(self);
+}
+
+bool
+PxDynaset_SetRow(PxDynasetObject* self, Py_ssize_t nRow)
+{
+	return PxDynaset_MoveRow(self, nRow, false);
 }
 
 static bool
@@ -1521,19 +6395,36 @@ PxDynaset_RefreshBoundWidgets(PxDynasetObject* self, bool bNonTable, bool bTable
 	return true;
 }
 
+static bool
+PxDynaset_RowsAppended(PxDynasetObject* self, Py_ssize_t nFirstRow)
+// rows from nFirstRow on have been pulled from the cursor, let tables append them
+{
+	PxWidgetObject* pyDependent;
+	PyObject* pyResult;
+	Py_ssize_t n, nLen;
+
+	nLen = PySequence_Size(self->pyWidgets);
+	for (n = 0; n < nLen; n++) {
+		pyDependent = (PxWidgetObject*)PyList_GetItem(self->pyWidgets, n);
+		if (pyDependent->bTable) {
+			if ((pyResult = PyObject_CallMethod((PyObject*)pyDependent, "append_rows", "n", nFirstRow)) == NULL)
+				return false;
+			Py_DECREF(pyResult);
+		}
+	}
+	return true;
+}
+
 static bool
 PxDynaset_UpdateControlWidgets(PxDynasetObject* self)
 {
 	bool bDelete = false, bClean = true, bEnable = false;
-	if (self->nRow != -1) {
-		PyObject* pyRow = PyList_GetItem(self->pyRows, self->nRow);
+	if (self->nRow != -1 && self->nRow < self->nRows) {
+		unsigned char cState = PxDynaset_GetRowState(self, self->nRow);
 
-		//bNew = (PyStructSequence_GetItem(pyRow, PXDYNASETROW_NEW) == Py_True);
-		bDelete = (PyStructSequence_GetItem(pyRow, PXDYNASETROW_DELETE) == Py_True);
-		bClean = (PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATAOLD) == Py_None);
-
-		if (PyErr_Occurred())
-			return false;
+		//bNew = (cState & PxROW_NEW);
+		bDelete = (cState & PxROW_DELETE);
+		bClean = !(cState & PxROW_MODIFIED);
 	}
 
 	if (self->pyEditButton) {
@@ -1586,6 +6477,7 @@ static PyMethodDef PxDynaset_ControlButtons[] = {
 static int
 PxDynaset_setattro(PxDynasetObject* self, PyObject* pyAttributeName, PyObject *pyValue)
 {
+	PxDynasetColumnInfo* pInfo;
 	if (PyUnicode_Check(pyAttributeName)) {
 		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "autoColumn") == 0) {
 
@@ -1606,16 +6498,29 @@ PxDynaset_setattro(PxDynasetObject* self, PyObject* pyAttributeName, PyObject *p
 				PyStructSequence_SetItem(pyValue, PXDYNASETCOLUMN_KEY, Py_True);
 				Py_INCREF(Py_True);
 			}
+			if ((pInfo = PxDynaset_FindColumn(self, pyValue)) == NULL) {
+				PyErr_SetString(PyExc_ValueError, "'autoColumn' must be a column of this Dynaset.");
+				return -1;
+			}
+			pInfo->iKey = 1;
+			Py_CLEAR(self->pyEmptyRowData);
 
 			Py_XDECREF(self->pyAutoColumn);
 			self->pyAutoColumn = pyValue;
 			Py_INCREF(self->pyAutoColumn);
+			PxDynaset_ForgetStatements(self);
 			return 0;
 		}
 
 		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "row") == 0) {
 			return PxDynaset_SetRow(self, PyLong_AsSsize_t(pyValue)) ? 0 : -1;
 		}
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "watchInterval") == 0) {
+			long iInterval = PyLong_AsLong(pyValue);
+			if (iInterval == -1 && PyErr_Occurred())
+				return -1;
+			return PxDynaset_Watch(self, (int)iInterval) ? 0 : -1;
+		}
 		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "buttonNew") == 0) {
 			PxAttachObject(&self->pyNewButton, pyValue, true);
 			gtk_button_set_image(self->pyNewButton->gtk, gtk_image_new_from_stock(GTK_STOCK_NEW, GTK_ICON_SIZE_SMALL_TOOLBAR));
@@ -1738,24 +6643,50 @@ PxDynaset_getattro(PxDynasetObject* self, PyObject* pyAttributeName)
 			else
 				Py_RETURN_NONE;
 		}
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "rowsVisible") == 0) {
+			PyErr_Clear();
+			return PyLong_FromSsize_t(PxDynaset_ViewRows(self));
+		}
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "filtered") == 0) {
+			PyErr_Clear();
+			return PyBool_FromLong(self->pnVisible != NULL);
+		}
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "selection") == 0) {
+			PyErr_Clear();
+			return PxDynaset_SelectionList(self);
+		}
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "canUndo") == 0) {
+			PyErr_Clear();
+			return PyBool_FromLong(self->nJournalPosition > 0);
+		}
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "canRedo") == 0) {
+			PyErr_Clear();
+			return PyBool_FromLong(self->nJournalPosition < self->nJournal);
+		}
 		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "lastInsertSQL") == 0) {
 			PyErr_Clear();
-			if (self->sInsertSQL)
-				return PyUnicode_FromString(self->sInsertSQL);
+			if (self->pStatements[PxSTATEMENT_INSERT]) {
+				Py_INCREF(self->pStatements[PxSTATEMENT_INSERT]->pySQL);
+				return self->pStatements[PxSTATEMENT_INSERT]->pySQL;
+			}
 			else
 				Py_RETURN_NONE;
 		}
 		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "lastUpdateSQL") == 0) {
 			PyErr_Clear();
-			if (self->sUpdateSQL)
-				return PyUnicode_FromString(self->sUpdateSQL);
+			if (self->pStatements[PxSTATEMENT_UPDATE]) {
+				Py_INCREF(self->pStatements[PxSTATEMENT_UPDATE]->pySQL);
+				return self->pStatements[PxSTATEMENT_UPDATE]->pySQL;
+			}
 			else
 				Py_RETURN_NONE;
 		}
 		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "lastDeleteSQL") == 0) {
 			PyErr_Clear();
-			if (self->sDeleteSQL)
-				return PyUnicode_FromString(self->sDeleteSQL);
+			if (self->pStatements[PxSTATEMENT_DELETE]) {
+				Py_INCREF(self->pStatements[PxSTATEMENT_DELETE]->pySQL);
+				return self->pStatements[PxSTATEMENT_DELETE]->pySQL;
+			}
 			else
 				Py_RETURN_NONE;
 		}
@@ -1786,6 +6717,13 @@ PxDynaset_getattro(PxDynasetObject* self, PyObject* pyAttributeName)
 				Py_RETURN_NONE;
 		}
 
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "rows") == 0) {
+			PyErr_Clear();
+			if (self->bFetchComplete)
+				return PyLong_FromSsize_t(self->nRows);
+			else
+				Py_RETURN_NONE; // still loading
+		}
 		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "row") == 0) {
 			PyErr_Clear();
 			if (self->nRow == -1)
@@ -1824,21 +6762,58 @@ PxDynaset_str(PxDynasetObject* self)
 static void
 PxDynaset_dealloc(PxDynasetObject* self)
 {
+	Py_ssize_t n;
+
+	PxDynaset_StopWatching(self);
+	PxQuery_Free(self->pStatement); // before the connection it was prepared on
 	Py_XDECREF(self->pyParent);
 	Py_XDECREF(self->pyConnection);
 	Py_XDECREF(self->pyTable);
 	Py_XDECREF(self->pyCursor);
 	Py_XDECREF(self->pyColumns);
+	for (n = 0; n < self->nColumnInfo; n++)
+		PxDynaset_FreeSteps(self->pColumnInfo[n].pSteps, self->pColumnInfo[n].nSteps);
+	PyMem_RawFree(self->pColumnInfo);
+	PyMem_RawFree(self->pnVisible);
+	PyMem_RawFree(self->pnDirty);
+	PyMem_RawFree(self->pnSelected);
+	PxDynaset_ForgetJournal(self);
+	Py_XDECREF(self->pyKeyIndex);
+	Py_XDECREF(self->pyCache);
+	Py_XDECREF(self->pyCacheKey);
+	Py_XDECREF(self->pyParameters);
 	Py_XDECREF(self->pyAutoColumn);
 	Py_XDECREF(self->pyRows);
+	PxColumnStore_Free(self->pStore);
 	Py_XDECREF(self->pyChildren);
 	Py_XDECREF(self->pyEmptyRowData);
 	Py_XDECREF(self->pyQuery);
+	Py_XDECREF(self->pyParams);
+	PxDynaset_ForgetStatements(self);
 	Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+static PySequenceMethods PxDynaset_as_sequence = {
+	(lenfunc)PxDynaset_length,  /* sq_length */
+	0,                          /* sq_concat */
+	0,                          /* sq_repeat */
+	(ssizeargfunc)PxDynaset_item, /* sq_item */
+};
+
 static PyMemberDef PxDynaset_members[] = {
-	{ "rows", T_PYSSIZET, offsetof(PxDynasetObject, nRows), READONLY, "Row count. -1 if still not executed." },
+	{ "rowsFetched", T_PYSSIZET, offsetof(PxDynasetObject, nRows), READONLY, "Number of rows loaded so far." },
+	{ "fetchSize", T_PYSSIZET, offsetof(PxDynasetObject, nFetchSize), 0, "Rows pulled from the cursor per window. 0 loads all rows on execute." },
+	{ "fetchComplete", T_BOOL, offsetof(PxDynasetObject, bFetchComplete), READONLY, "All rows of the query have been loaded." },
+	{ "loading", T_BOOL, offsetof(PxDynasetObject, bLoading), READONLY, "A query is running in the background." },
+	{ "paged", T_BOOL, offsetof(PxDynasetObject, bPaged), 0, "Keep only pagesKept pages of fetchSize rows, read in key order as the rows are scrolled to. What needs all rows, as len(), locate, the aggregates, column_buffer and export, raises RuntimeError." },
+	{ "pagesKept", T_PYSSIZET, offsetof(PxDynasetObject, nPagesKept), 0, "Pages a paged Dynaset holds in memory at most." },
+	{ "rowOffset", T_PYSSIZET, offsetof(PxDynasetObject, nRowOffset), READONLY, "Position of the first loaded row in the whole result of a paged Dynaset." },
+	{ "rowsTotal", T_PYSSIZET, offsetof(PxDynasetObject, nRowsTotal), READONLY, "Rows of the whole result of a paged Dynaset as counted on execute, -1 if not paged." },
+	{ "childRefreshDelay", T_INT, offsetof(PxDynasetObject, iChildRefreshDelay), 0, "Milliseconds the row pointer has to rest before child Dynasets are refreshed. 0 refreshes them at once." },
+	{ "watchInterval", T_INT, offsetof(PxDynasetObject, iWatchInterval), 0, "Milliseconds between checks whether the database has been changed elsewhere. 0 does not check." },
+	{ "autoRefresh", T_BOOL, offsetof(PxDynasetObject, bAutoRefresh), 0, "Merge changes made elsewhere in as soon as the Dynaset is stale and has no unsaved changes." },
+	{ "stale", T_BOOL, offsetof(PxDynasetObject, bStale), READONLY, "The database has been changed elsewhere since the rows were loaded." },
+	{ "cacheSize", T_PYSSIZET, offsetof(PxDynasetObject, nCacheSize), 0, "Number of results a child Dynaset keeps for revisited parent rows. 0 queries every time." },
 	{ "query", T_OBJECT, offsetof(PxDynasetObject, pyQuery), 0, "Query string" },
 	{ "autoExecute", T_BOOL, offsetof(PxDynasetObject, bAutoExecute), 0, "Execute query if parent row has changed." },
 	{ "readOnly", T_BOOL, offsetof(PxDynasetObject, bReadOnly), 0, "Data can not be edited." },
@@ -1851,13 +6826,37 @@ static PyMethodDef PxDynaset_methods[] = {
 	{ "add_column", (PyCFunction)PxDynaset_add_column, METH_VARARGS | METH_KEYWORDS, "Add a data column" },
 	{ "get_column", (PyCFunction)PxDynaset_get_column, METH_VARARGS, "Returns a data column as named tuple." },
 	{ "execute", (PyCFunction)PxDynaset_execute, METH_VARARGS | METH_KEYWORDS, "Run the query" },
+	{ "execute_async", (PyCFunction)PxDynaset_execute_async, METH_VARARGS | METH_KEYWORDS, "Run the query on a worker thread, rows are loaded when it has finished." },
 	{ "get_row", (PyCFunction)PxDynaset_get_row, METH_VARARGS, "Returns a data row as named tuple." },
 	{ "get_data", (PyCFunction)PxDynaset_get_data, METH_VARARGS, "Returns the data for a row/column combination" },
 	{ "set_data", (PyCFunction)PxDynaset_set_data, METH_VARARGS, "Sets the data for a row/column combination" },
 	{ "get_row_data", (PyCFunction)PxDynaset_get_row_data, METH_VARARGS, "Returns a data row as named tuple." },
-	{ "get_column_data_sum", (PyCFunction)PxDynaset_get_column_data_sum, METH_VARARGS, "Returns the sum of the data for column." },
+	{ "locate", (PyCFunction)PxDynaset_locate, METH_VARARGS, "Returns the number of the row with the key values given in key column order, -1 if there is none." },
+	{ "seek", (PyCFunction)PxDynaset_seek, METH_VARARGS, "Moves the row pointer to the row with the key values given in key column order. Returns False if there is none." },
+	{ "get_column_data_sum", (PyCFunction)PxDynaset_sum, METH_VARARGS, "Returns the sum of the data for column." },
+	{ "sum", (PyCFunction)PxDynaset_sum, METH_VARARGS, "Returns the sum of the values in column over the rows shown." },
+	{ "min", (PyCFunction)PxDynaset_min, METH_VARARGS, "Returns the smallest value in column over the rows shown, None if there is none." },
+	{ "max", (PyCFunction)PxDynaset_max, METH_VARARGS, "Returns the largest value in column over the rows shown, None if there is none." },
+	{ "avg", (PyCFunction)PxDynaset_avg, METH_VARARGS, "Returns the mean of the values in column over the rows shown, None if there is none." },
+	{ "count", (PyCFunction)PxDynaset_count, METH_VARARGS, "Returns the number of values that are not None in column over the rows shown." },
+	{ "iter_column", (PyCFunction)PxDynaset_iter_column, METH_VARARGS, "Returns an iterator over the values of column in all rows, fetching as it goes." },
+	{ "count_distinct", (PyCFunction)PxDynaset_count_distinct, METH_VARARGS, "Returns the number of different values that are not None in column over the rows shown." },
+	{ "column_buffer", (PyCFunction)PxDynaset_column_buffer, METH_VARARGS, "Returns a read-only buffer over the native int64 or double values of column in all rows, with a NULL mask as its attribute valid. Rows cannot be added while it is in use." },
+	{ "fetch_all", (PyCFunction)PxDynaset_fetch_all, METH_NOARGS, "Loads the rows still pending in the cursor." },
+	{ "export", (PyCFunction)PxDynaset_export, METH_VARARGS | METH_KEYWORDS, "Write the rows shown, or with query=True the query's result read anew, to a CSV or JSON Lines file. Returns the number of rows." },
+	{ "import_rows", (PyCFunction)PxDynaset_import_rows, METH_VARARGS | METH_KEYWORDS, "Append the rows of an iterable or a CSV file as new rows, mapping is a dict of item keys to columns. Returns the number of rows." },
+	{ "refresh", (PyCFunction)PxDynaset_refresh, METH_VARARGS | METH_KEYWORDS, "Run the query again with the same parameters, with merge=True change only the rows that differ." },
 	{ "clear", (PyCFunction)PxDynaset_clear, METH_NOARGS, "Empties the data." },
+	{ "sort", (PyCFunction)PxDynaset_sort, METH_VARARGS | METH_KEYWORDS, "Sort the rows in memory by one or more columns." },
+	{ "filter", (PyCFunction)PxDynaset_filter, METH_VARARGS | METH_KEYWORDS, "Show only the rows passing a column comparison or a predicate, returns their number." },
+	{ "clear_filter", (PyCFunction)PxDynaset_clear_filter, METH_NOARGS, "Show all rows again." },
 	{ "save", (PyCFunction)PxDynaset_save, METH_NOARGS, "Save the data." },
+	{ "select", (PyCFunction)PxDynaset_select, METH_VARARGS, "Make the rows of a sequence of row numbers the selection, None selects none." },
+	{ "delete_rows", (PyCFunction)PxDynaset_delete_rows, METH_VARARGS | METH_KEYWORDS, "Mark the rows given, else the rows selected, else the current row for deletion. Returns the number of rows newly marked." },
+	{ "set_data_rows", (PyCFunction)PxDynaset_set_data_rows, METH_VARARGS | METH_KEYWORDS, "Set column to value in the rows given, else the rows selected, else the current row. Returns the number of rows." },
+	{ "copy", (PyCFunction)PxDynaset_copy, METH_VARARGS | METH_KEYWORDS, "Put the rows given, else the rows selected, else the current row on the clipboard as tab separated text, which is returned." },
+	{ "undo", (PyCFunction)PxDynaset_undo_edit, METH_NOARGS, "Take back the latest cell edit not yet saved, in whatever row. Returns False if there is none." },
+	{ "redo", (PyCFunction)PxDynaset_redo_edit, METH_NOARGS, "Make the cell edit taken back last again. Returns False if there is none." },
 	{ NULL }
 };
 
@@ -1873,7 +6872,7 @@ PyTypeObject PxDynasetType = {
 	0,                         /* tp_reserved */
 	PxDynaset_str,             /* tp_repr */
 	0,                         /* tp_as_number */
-	0,                         /* tp_as_sequence */
+	&PxDynaset_as_sequence,    /* tp_as_sequence */
 	0,                         /* tp_as_mapping */
 	0,                         /* tp_hash  */
 	0,                         /* tp_call */
@@ -1887,7 +6886,7 @@ PyTypeObject PxDynasetType = {
 	0,                         /* tp_clear */
 	0,                         /* tp_richcompare */
 	0,                         /* tp_weaklistoffset */
-	0,                         /* tp_iter */
+	(getiterfunc)PxDynaset_iter, /* tp_iter */
 	0,                         /* tp_iternext */
 	PxDynaset_methods,         /* tp_methods */
 	PxDynaset_members,         /* tp_members */
@@ -17,7 +17,68 @@
 #define PXDYNASETCOLUMN_DEFFUNC 5
 #define PXDYNASETCOLUMN_FORMAT 6
 #define PXDYNASETCOLUMN_PARENT 7
+#define PXDYNASETCOLUMN_EXPR 8 // formula or callable of a computed column, None if the column holds data as loaded
 
+// kinds of statements writing rows back to the database
+#define PxSTATEMENT_INSERT 0
+#define PxSTATEMENT_UPDATE 1
+#define PxSTATEMENT_DELETE 2
+
+#define PxAGGREGATE_SUM            0
+#define PxAGGREGATE_MIN            1
+#define PxAGGREGATE_MAX            2
+#define PxAGGREGATE_AVG            3
+#define PxAGGREGATE_COUNT          4
+#define PxAGGREGATE_COUNT_DISTINCT 5
+
+typedef struct _PxDynasetStatement
+{
+	PyObject* pySQL;          // text with a '?' for each parameter
+	Py_ssize_t nParams;
+	Py_ssize_t* pnColumns;    // position in the row data of each parameter
+}
+PxDynasetStatement;
+
+// operations of computed column formulas, compiled to postfix order
+#define PxEXPR_COLUMN   0
+#define PxEXPR_CONSTANT 1
+#define PxEXPR_ADD      2
+#define PxEXPR_SUBTRACT 3
+#define PxEXPR_MULTIPLY 4
+#define PxEXPR_DIVIDE   5
+#define PxEXPR_NEGATE   6
+#define PxEXPR_CONCAT   7
+#define PxEXPR_COALESCE 8
+
+typedef struct _PxExprStep
+{
+	int iOperation;
+	Py_ssize_t nArgument;     // PxEXPR_COLUMN: position of the column in pColumnInfo, PxEXPR_COALESCE: number of operands
+	PyObject* pyValue;        // PxEXPR_CONSTANT: the value
+}
+PxExprStep;
+
+typedef struct _PxDynasetColumnInfo
+{
+	PyObject* pyColumn;       // DynasetColumn presenting this entry to Python, borrowed from pyColumns
+	Py_ssize_t nIndex;        // position in the row data, -1 if not part of the query
+	PxColumnKind iKind;       // storage class of the declared type
+	signed char iKey;         // 1 = part of primary key, 0 = non-key database column, -1 = not in database
+	PyObject* pyParentColumn; // DynasetColumn of the parent Dynaset, NULL if none
+	PyObject* pyExpr;         // formula or callable of a computed column, borrowed from the DynasetColumn, NULL if not computed
+	PxExprStep* pSteps;       // the formula compiled, NULL if pyExpr is callable
+	Py_ssize_t nSteps;
+}
+PxDynasetColumnInfo;
+
+typedef struct _PxJournalEntry
+{
+	Py_ssize_t nRow;
+	Py_ssize_t nColumn;       // position in the row data
+	PyObject* pyData;         // what the cell held before the edit, once undone what it held after
+	unsigned char cState;     // row state before the edit, once undone the state after
+}
+PxJournalEntry;
 
 typedef struct _PxWidgetObject PxWidgetObject;
 typedef struct _PxButtonObject PxButtonObject;
@@ -31,17 +92,59 @@ typedef struct _PxDynasetObject
 	PyObject* pyTable;    // name of table in database
 	PyObject* pyQuery;
 	PyObject* pyCursor;
+	bool bDirect;         // read and write rows through the SQLite C API on the connection's own handle, bypassing the sqlite3 module
+	PxQuery* pStatement;  // the query rows are stepped from in place of pyCursor if bDirect, NULL if none open
 	PyObject* pyColumns;  // PyDict
+	PxDynasetColumnInfo* pColumnInfo; // one per column in order of add_column, what the C code works with
+	Py_ssize_t nColumnInfo;
+	Py_ssize_t nDataColumns; // number of items in the row data
+	Py_ssize_t nComputed; // columns whose data is derived from the other columns of the row
 	PyObject* pyAutoColumn;  // column which gets automatically populated by the database by an ID
-	PyObject* pyRows;     // PyList
+	PyObject* pyRows;     // PyList of DynasetRow, unused if columnar
+	PxColumnStore* pStore; // native row storage of a columnar Dynaset, NULL otherwise
+	bool bColumnar;       // keep rows in pStore
 	PyObject* pyEmptyRowData; // Tuple
-	char* sInsertSQL;
-	char* sUpdateSQL;
-	char* sDeleteSQL;
+	PxDynasetStatement* pStatements[3]; // INSERT, UPDATE and DELETE for the current column set, generated when first needed
 	PyObject* pyParams;
 	Py_ssize_t nRows;     // number of rows
 	Py_ssize_t nRow;      // pointer to current row, -1 if none
-	Py_ssize_t nRowEnd;   // for later, to select a region
+	Py_ssize_t nRowGeneration; // counts the changes moving rows to other numbers, row proxies of an earlier one are void
+	Py_ssize_t* pnSelected; // rows selected for batch operations in ascending order, NULL if none
+	Py_ssize_t nSelected;
+	Py_ssize_t nFetchSize; // rows pulled from the cursor per window, 0 to fetch all at once
+	bool bFetchComplete;  // cursor is exhausted, nRows is the final row count
+	guint iFetchSourceID; // idle source pulling the next window, 0 if none pending
+	bool bPaged;          // hold only a window of pages read by key instead of the whole result
+	Py_ssize_t nPagesKept; // pages of nFetchSize rows a paged Dynaset holds at most
+	bool bPageStart;      // the window begins with the first row of the result
+	Py_ssize_t nRowOffset; // position of row 0 in the whole result
+	Py_ssize_t nRowsTotal; // rows of the whole result of a paged Dynaset as counted on execute, -1 if not paged
+	PyObject* pyParameters; // parameters the query has last been executed with, for reading further pages and merged refreshes
+	guint iPageSourceID;  // idle source reading the page before the window, 0 if none pending
+	int iChildRefreshDelay; // ms the row pointer has to rest before child Dynasets are refreshed, 0 for at once
+	guint iChildRefreshSourceID; // timeout source refreshing the children, 0 if none pending
+	Py_ssize_t* pnVisible; // rows passing the filter in ascending order, NULL if not filtered
+	Py_ssize_t nVisible;
+	Py_ssize_t* pnDirty;  // rows that may be new, deleted or modified in ascending order, so saving skips clean rows
+	Py_ssize_t nDirty;
+	Py_ssize_t nDirtyCapacity;
+	PxJournalEntry* pJournal; // cell edits since the rows were loaded or saved, oldest first
+	Py_ssize_t nJournal;
+	Py_ssize_t nJournalPosition; // entries from here on have been undone and can be redone
+	Py_ssize_t nJournalCapacity;
+	PyObject* pyKeyIndex; // PyDict from tuple of key values to row number, NULL until a row is located and whenever rows have moved
+	PxQuery* pQuery;      // query running on a worker thread, NULL if none
+	Py_ssize_t nCacheSize; // child results to keep, 0 to always query
+	PyObject* pyCache;    // PyDict from tuple of parent values to tuple of row data tuples, least recently used first
+	PyObject* pyCacheKey; // parent values the current rows were loaded for, NULL if they are not to be cached
+	long long iCacheChanges; // total_changes of the connection the cached results are valid for
+	long long iCacheVersion; // data_version of the database
+	int iWatchInterval;   // ms between checks for changes committed elsewhere, 0 if not watching
+	guint iWatchSourceID; // timeout source of the checks, holds no reference
+	long long iWatchVersion; // data_version the rows have been loaded at
+	bool bStale;          // the database has been changed elsewhere since the rows were loaded
+	bool bAutoRefresh;    // merge the changes in when stale
+	bool bLoading;        // waiting for pQuery
 	long iLastRowID;
 	PyObject* pyWidgets;  // PyList
 	PyObject* pyChildren; // PyList
@@ -70,15 +173,22 @@ extern PyTypeObject PxDynasetColumnType;
 extern PyTypeObject PxDynasetRowType;
 
 bool PxDynasetTypes_Init(void);
+unsigned char PxDynaset_GetRowState(PxDynasetObject* self, Py_ssize_t nRow);
 PyObject* PxDynaset_GetData(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn);
 bool PxDynaset_SetData(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn, PyObject* pyData);
 PyObject* PxDynaset_execute(PxDynasetObject* self, PyObject* args, PyObject* kwds);
 bool PxDynaset_Clear(PxDynasetObject* self);
+Py_ssize_t PxDynaset_ViewRows(PxDynasetObject* self);
+Py_ssize_t PxDynaset_ViewRow(PxDynasetObject* self, Py_ssize_t nPosition);
+Py_ssize_t PxDynaset_ViewPosition(PxDynasetObject* self, Py_ssize_t nRow);
+bool PxDynaset_Sort(PxDynasetObject* self, Py_ssize_t nKeys, PyObject** ppyColumns, const bool* pbDescending);
+PyObject* PxDynaset_Aggregate(PxDynasetObject* self, PyObject* pyColumn, int iFunction);
 PyObject* PxDynaset_GetRowDataDict(PxDynasetObject* self, Py_ssize_t nRow, bool bKeysOnly);
 bool PxDynaset_Save(PxDynasetObject* self);
 bool PxDynaset_NewRow(PxDynasetObject* self, Py_ssize_t nRow);
 bool PxDynaset_Undo(PxDynasetObject* self, Py_ssize_t nRow);
 bool PxDynaset_DeleteRow(PxDynasetObject* self, Py_ssize_t nRow);
+bool PxDynaset_Select(PxDynasetObject* self, const Py_ssize_t* pnRows, Py_ssize_t nCount, PxWidgetObject* pySource);
 bool PxDynaset_AddWidget(PxDynasetObject*, PxWidgetObject*);
 bool PxDynaset_RemoveWidget(PxDynasetObject* self, PxWidgetObject* widget);
 bool PxDynaset_Freeze(PxDynasetObject* self);
@@ -87,5 +197,8 @@ bool PxDynaset_Stain(PxDynasetObject* self);
 bool PxDynaset_UnStain(PxDynasetObject* self);
 bool PxDynaset_SetRow(PxDynasetObject* self, Py_ssize_t nRow);
 bool PxDynaset_DataChanged(PxDynasetObject* self, Py_ssize_t nRow, PyObject* pyColumn);
+bool PxDynaset_FetchTo(PxDynasetObject* self, Py_ssize_t nRow);
+void PxDynaset_RequestFetch(PxDynasetObject* self);
+void PxDynaset_RequestPreviousPage(PxDynasetObject* self);
 
 #endif
@@ -100,9 +100,12 @@ PxEntry_refresh(PxEntryObject* self)
 		//Xx("freshc pyData",pyData);
 		if (!PyObject_RichCompareBool(self->pyData, pyData, Py_EQ)) {
 			PxAttachObject(&self->pyData, pyData, true);
-			if (!PxEntry_RenderData(self, true))
+			if (!PxEntry_RenderData(self, true)) {
+				Py_DECREF(pyData);
 				Py_RETURN_FALSE;
+			}
 		}
+		Py_DECREF(pyData);
 		gtk_widget_set_sensitive(self->gtk, !(self->bReadOnly || self->pyDynaset->bLocked));
 	}
 		//Xx("PxEntry_refresh 2",self);
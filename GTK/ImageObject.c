@@ -182,6 +182,7 @@ PxImage_refresh(PxImageObject* self)
 		if (!PyObject_RichCompareBool(self->pyData, pyData, Py_EQ)) {
 			PxAttachObject(&self->pyData, pyData, true);
 		}
+		Py_XDECREF(pyData);
 		if (!PxImage_RenderData(self, true))
 			Py_RETURN_FALSE;
 		gtk_widget_set_sensitive(self->gtk, !(self->bReadOnly || self->pyDynaset->bLocked));
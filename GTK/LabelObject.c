@@ -192,9 +192,12 @@ PxLabel_refresh(PxLabelObject* self)
 		PyObject* pyData = PxWidget_PullData((PxWidgetObject*)self);
 		if (!PyObject_RichCompareBool(self->pyData, pyData, Py_EQ)) {
 			PxAttachObject(&self->pyData, pyData, true);
-			if (!PxLabel_RenderData(self, true))
+			if (!PxLabel_RenderData(self, true)) {
+				Py_XDECREF(pyData);
 				Py_RETURN_FALSE;
+			}
 		}
+		Py_XDECREF(pyData);
 	}
 	Py_RETURN_TRUE;
 }
@@ -107,6 +107,9 @@ PyInit_pylax(void)
 	if (PyType_Ready(&PxTableColumnType) < 0)
 		return NULL;
 
+	if (PyType_Ready(&PxColumnBufferType) < 0)
+		return NULL;
+
 	if (!PxDynasetTypes_Init())
 		return NULL;
 
@@ -132,6 +135,7 @@ PyInit_pylax(void)
 	Py_INCREF(&PxTabPageType);
 	Py_INCREF(&PxTableType);
 	Py_INCREF(&PxTableColumnType);
+	Py_INCREF(&PxColumnBufferType);
 
 	PyModule_AddObject(pyModule, "Dynaset", (PyObject *)&PxDynasetType);
 	PyModule_AddObject(pyModule, "Image", (PyObject *)&PxImageType);
@@ -152,6 +156,7 @@ PyInit_pylax(void)
 	PyModule_AddObject(pyModule, "TabPage", (PyObject *)&PxTabPageType);
 	PyModule_AddObject(pyModule, "Table", (PyObject *)&PxTableType);
 	PyModule_AddObject(pyModule, "TableColumn", (PyObject *)&PxTableColumnType);
+	PyModule_AddObject(pyModule, "ColumnBuffer", (PyObject *)&PxColumnBufferType);
 
 	if (PyDict_SetItemString(PxWidgetType.tp_dict, "defaultCoordinate", PyLong_FromLong(PxDEFAULT)) == -1)
 		return NULL;
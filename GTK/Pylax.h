@@ -11,12 +11,18 @@
 #include <string.h>
 #include <unistd.h>
 #include <limits.h>
+#include <dlfcn.h>
 
 // GTK Header Files
 #include <gtk/gtk.h>
 
+// SQLite Header Files
+#include <sqlite3.h>
+
 // Pylax Classes
 #include "Version.h"
+#include "ColumnStore.h"
+#include "Query.h"
 #include "DynasetObject.h"
 #include "MenuObject.h"
 #include "WidgetObject.h"
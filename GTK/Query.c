@@ -0,0 +1,681 @@
+﻿// Query.c  | Pylax © 2017 by Thomas Führinger
+#include "Pylax.h"
+
+static char*
+PxQuery_StrDup(const char* sText, int nLength)
+// copy to the heap, nLength -1 for a 0 terminated string
+{
+	char* sCopy;
+	if (nLength < 0)
+		nLength = (int)strlen(sText);
+	if ((sCopy = (char*)PyMem_RawMalloc(nLength + 1)) == NULL)
+		return NULL;
+	memcpy(sCopy, sText, nLength);
+	sCopy[nLength] = '\0';
+	return sCopy;
+}
+
+static char*
+PxQuery_StrDupUpper(const char* sText, int nLength)
+{
+	char* sCopy = PxQuery_StrDup(sText, nLength), *s;
+	if (sCopy)
+		for (s = sCopy; *s; s++)
+			if (*s >= 'a' && *s <= 'z')
+				*s -= 'a' - 'A';
+	return sCopy;
+}
+
+static bool
+PxQuery_SetValue(PxQueryValue* pValue, PyObject* pyData)
+// convert a parameter on the main thread, like the sqlite3 module would bind it
+{
+	PyObject* pyAdapted = NULL, *pyProtocol;
+	Py_buffer buffer;
+	const char* sText;
+	Py_ssize_t nLength;
+	int iOverflow;
+	bool bOk = true;
+
+	if (!(pyData == Py_None || PyLong_CheckExact(pyData) || PyFloat_CheckExact(pyData) || PyUnicode_CheckExact(pyData) || PyBytes_CheckExact(pyData))) {
+		// dates and the like go through the adapters registered with the sqlite3 module, without one the value stays itself, bools and int enums bind as ints
+		if ((pyProtocol = PyObject_GetAttrString(g.pySQLiteModule, "PrepareProtocol")) == NULL)
+			return false;
+		pyAdapted = PyObject_CallMethod(g.pySQLiteModule, "adapt", "(OOO)", pyData, pyProtocol, pyData);
+		Py_DECREF(pyProtocol);
+		if (pyAdapted == NULL)
+			return false;
+		pyData = pyAdapted;
+	}
+
+	if (pyData == Py_None)
+		pValue->iType = SQLITE_NULL;
+	else if (PyLong_Check(pyData)) {
+		pValue->iType = SQLITE_INTEGER;
+		pValue->v.i = PyLong_AsLongLongAndOverflow(pyData, &iOverflow);
+		if (iOverflow) {
+			PyErr_SetString(PyExc_OverflowError, "Python int too large to convert to SQLite INTEGER");
+			bOk = false;
+		}
+	}
+	else if (PyFloat_Check(pyData)) {
+		pValue->iType = SQLITE_FLOAT;
+		pValue->v.f = PyFloat_AsDouble(pyData);
+	}
+	else if (PyUnicode_Check(pyData)) {
+		pValue->iType = SQLITE_TEXT;
+		if ((sText = PyUnicode_AsUTF8AndSize(pyData, &nLength)) == NULL || (pValue->v.b.s = PxQuery_StrDup(sText, (int)nLength)) == NULL)
+			bOk = false;
+		pValue->v.b.n = (int)nLength;
+	}
+	else if (PyObject_CheckBuffer(pyData)) {
+		pValue->iType = SQLITE_BLOB;
+		if (PyObject_GetBuffer(pyData, &buffer, PyBUF_SIMPLE) == -1)
+			bOk = false;
+		else {
+			if ((pValue->v.b.s = PxQuery_StrDup((const char*)buffer.buf, (int)buffer.len)) == NULL)
+				bOk = false;
+			pValue->v.b.n = (int)buffer.len;
+			PyBuffer_Release(&buffer);
+		}
+	}
+	else {
+		PyErr_Format(PyExc_TypeError, "Type '%.200s' is not supported as query parameter.", Py_TYPE(pyData)->tp_name);
+		bOk = false;
+	}
+
+	if (!bOk && !PyErr_Occurred())
+		PyErr_NoMemory();
+	Py_XDECREF(pyAdapted);
+	return bOk;
+}
+
+PxQuery*
+PxQuery_New(const char* sDatabase, PyObject* pyQuery, PyObject* pyParameters)
+// prepare everything the worker needs, while the GIL is held
+{
+	PxQuery* pQuery;
+	PyObject* pyConverters, *pyKey, *pyValue, *pyItems = NULL;
+	Py_ssize_t nPos = 0, n;
+
+	if ((pQuery = (PxQuery*)PyMem_RawCalloc(1, sizeof(PxQuery))) == NULL) {
+		PyErr_NoMemory();
+		return NULL;
+	}
+	if ((sDatabase && (pQuery->sDatabase = PxQuery_StrDup(sDatabase, -1)) == NULL) || (pQuery->sSQL = PxQuery_StrDup(PyUnicode_AsUTF8(pyQuery), -1)) == NULL)
+		goto ERROR;
+
+	if (pyParameters && pyParameters != Py_None) {
+		if (PyDict_Check(pyParameters))
+			pyItems = PyDict_Values(pyParameters);
+		else
+			pyItems = PySequence_Fast(pyParameters, "Parameters must be a dict or a sequence.");
+		if (pyItems == NULL)
+			goto ERROR;
+		pQuery->nParams = (int)PySequence_Fast_GET_SIZE(pyItems);
+		if ((pQuery->pParams = (PxQueryValue*)PyMem_RawCalloc(pQuery->nParams ? pQuery->nParams : 1, sizeof(PxQueryValue))) == NULL)
+			goto ERROR;
+		for (n = 0; n < pQuery->nParams; n++)
+			if (!PxQuery_SetValue(pQuery->pParams + n, PySequence_Fast_GET_ITEM(pyItems, n)))
+				goto ERROR;
+
+		if (PyDict_Check(pyParameters)) {
+			if ((pQuery->psParamNames = (char**)PyMem_RawCalloc(pQuery->nParams ? pQuery->nParams : 1, sizeof(char*))) == NULL)
+				goto ERROR;
+			n = 0;
+			while (PyDict_Next(pyParameters, &nPos, &pyKey, &pyValue)) {
+				if (!PyUnicode_Check(pyKey)) {
+					PyErr_SetString(PyExc_TypeError, "Parameter names must be strings.");
+					goto ERROR;
+				}
+				if ((pQuery->psParamNames[n++] = PxQuery_StrDup(PyUnicode_AsUTF8(pyKey), -1)) == NULL)
+					goto ERROR;
+			}
+		}
+		Py_CLEAR(pyItems);
+	}
+
+	// the worker decides which columns need a converter, the main thread calls it
+	if ((pyConverters = PyObject_GetAttrString(g.pySQLiteModule, "converters")) == NULL)
+		goto ERROR;
+	pQuery->nConverters = (int)PyDict_Size(pyConverters);
+	pQuery->psConverters = (char**)PyMem_RawCalloc(pQuery->nConverters ? pQuery->nConverters : 1, sizeof(char*));
+	pQuery->pyConverters = PyTuple_New(pQuery->nConverters);
+	if (pQuery->psConverters == NULL || pQuery->pyConverters == NULL) {
+		Py_DECREF(pyConverters);
+		goto ERROR;
+	}
+	nPos = 0;
+	n = 0;
+	while (PyDict_Next(pyConverters, &nPos, &pyKey, &pyValue)) {
+		if ((pQuery->psConverters[n] = PxQuery_StrDupUpper(PyUnicode_AsUTF8(pyKey), -1)) == NULL) {
+			Py_DECREF(pyConverters);
+			goto ERROR;
+		}
+		Py_INCREF(pyValue);
+		PyTuple_SET_ITEM(pQuery->pyConverters, n++, pyValue);
+	}
+	Py_DECREF(pyConverters);
+	return pQuery;
+
+ERROR:
+	if (!PyErr_Occurred())
+		PyErr_NoMemory();
+	Py_XDECREF(pyItems);
+	PxQuery_Free(pQuery);
+	return NULL;
+}
+
+static int
+PxQuery_ProgressCB(void* pUserData)
+// interrupts a long running statement once the result is not wanted any more
+{
+	return g_atomic_int_get(&((PxQuery*)pUserData)->iCancelled);
+}
+
+static int
+PxQuery_FindConverter(PxQuery* pQuery, const char* sName, int nLength)
+{
+	int n;
+	for (n = 0; n < pQuery->nConverters; n++)
+		if (strlen(pQuery->psConverters[n]) == (size_t)nLength && g_ascii_strncasecmp(pQuery->psConverters[n], sName, nLength) == 0)
+			return n;
+	return -1;
+}
+
+static bool
+PxQuery_DescribeColumns(PxQuery* pQuery, sqlite3_stmt* pStmt)
+// column names and converters as the sqlite3 module derives them with PARSE_DECLTYPES | PARSE_COLNAMES
+{
+	const char* sName, *sDeclType, *s, *sEnd;
+	int nColumn;
+
+	pQuery->nColumns = sqlite3_column_count(pStmt);
+	pQuery->psColumnNames = (char**)PyMem_RawCalloc(pQuery->nColumns ? pQuery->nColumns : 1, sizeof(char*));
+	pQuery->piConverters = (int*)PyMem_RawMalloc((pQuery->nColumns ? pQuery->nColumns : 1) * sizeof(int));
+	if (pQuery->psColumnNames == NULL || pQuery->piConverters == NULL)
+		return false;
+
+	for (nColumn = 0; nColumn < pQuery->nColumns; nColumn++) {
+		sName = sqlite3_column_name(pStmt, nColumn);
+		pQuery->piConverters[nColumn] = -1;
+
+		// 'name [type]' in the column name takes precedence over the declared type
+		if ((s = strchr(sName, '[')) != NULL && (sEnd = strchr(s, ']')) != NULL)
+			pQuery->piConverters[nColumn] = PxQuery_FindConverter(pQuery, s + 1, (int)(sEnd - s - 1));
+		if (s != NULL && s != sName && *(s - 1) == ' ')
+			s--;
+		if ((pQuery->psColumnNames[nColumn] = PxQuery_StrDup(sName, s ? (int)(s - sName) : -1)) == NULL)
+			return false;
+
+		if (pQuery->piConverters[nColumn] == -1 && (sDeclType = sqlite3_column_decltype(pStmt, nColumn)) != NULL) {
+			for (sEnd = sDeclType; *sEnd && *sEnd != ' ' && *sEnd != '('; sEnd++)
+				;
+			pQuery->piConverters[nColumn] = PxQuery_FindConverter(pQuery, sDeclType, (int)(sEnd - sDeclType));
+		}
+	}
+	return true;
+}
+
+static int
+PxQuery_Bind(PxQuery* pQuery, sqlite3_stmt* pStmt)
+{
+	const char* sName;
+	PxQueryValue* pValue;
+	int n, nParam, iResult = SQLITE_OK;
+
+	for (nParam = 1; nParam <= sqlite3_bind_parameter_count(pStmt) && iResult == SQLITE_OK; nParam++) {
+		pValue = NULL;
+		if (pQuery->psParamNames) {
+			if ((sName = sqlite3_bind_parameter_name(pStmt, nParam)) != NULL)
+				for (n = 0; n < pQuery->nParams; n++)
+					if (strcmp(pQuery->psParamNames[n], sName + 1) == 0) // skip the ':'
+						pValue = pQuery->pParams + n;
+		}
+		else if (nParam <= pQuery->nParams)
+			pValue = pQuery->pParams + nParam - 1;
+
+		if (pValue == NULL) {
+			pQuery->sError = PxQuery_StrDup("Incorrect number of bindings supplied or parameter missing.", -1);
+			return SQLITE_RANGE;
+		}
+		switch (pValue->iType) {
+		case SQLITE_INTEGER:
+			iResult = sqlite3_bind_int64(pStmt, nParam, pValue->v.i);
+			break;
+		case SQLITE_FLOAT:
+			iResult = sqlite3_bind_double(pStmt, nParam, pValue->v.f);
+			break;
+		case SQLITE_TEXT:
+			iResult = sqlite3_bind_text(pStmt, nParam, pValue->v.b.s, pValue->v.b.n, SQLITE_STATIC);
+			break;
+		case SQLITE_BLOB:
+			iResult = sqlite3_bind_blob(pStmt, nParam, pValue->v.b.s, pValue->v.b.n, SQLITE_STATIC);
+			break;
+		default:
+			iResult = sqlite3_bind_null(pStmt, nParam);
+		}
+	}
+	return iResult;
+}
+
+static bool
+PxQuery_AppendRow(PxQuery* pQuery, sqlite3_stmt* pStmt)
+{
+	PxQueryValue* pCell;
+	Py_ssize_t nCapacity;
+	const void* pData;
+	int nColumn;
+
+	if (pQuery->nRows == pQuery->nCapacity) {
+		nCapacity = pQuery->nCapacity ? pQuery->nCapacity * 2 : 256;
+		if ((pCell = (PxQueryValue*)PyMem_RawRealloc(pQuery->pCells, nCapacity * (pQuery->nColumns ? pQuery->nColumns : 1) * sizeof(PxQueryValue))) == NULL)
+			return false;
+		pQuery->pCells = pCell;
+		pQuery->nCapacity = nCapacity;
+	}
+
+	pCell = pQuery->pCells + pQuery->nRows * pQuery->nColumns;
+	for (nColumn = 0; nColumn < pQuery->nColumns; nColumn++, pCell++) {
+		pCell->iType = sqlite3_column_type(pStmt, nColumn);
+		if (pCell->iType != SQLITE_NULL && pQuery->piConverters[nColumn] != -1)
+			pCell->iType = SQLITE_BLOB; // converters get the raw bytes
+		switch (pCell->iType) {
+		case SQLITE_INTEGER:
+			pCell->v.i = sqlite3_column_int64(pStmt, nColumn);
+			break;
+		case SQLITE_FLOAT:
+			pCell->v.f = sqlite3_column_double(pStmt, nColumn);
+			break;
+		case SQLITE_TEXT:
+		case SQLITE_BLOB:
+			pData = (pCell->iType == SQLITE_TEXT) ? (const void*)sqlite3_column_text(pStmt, nColumn) : sqlite3_column_blob(pStmt, nColumn);
+			pCell->v.b.n = sqlite3_column_bytes(pStmt, nColumn);
+			if ((pCell->v.b.s = PxQuery_StrDup(pData ? (const char*)pData : "", pCell->v.b.n)) == NULL) {
+				pCell->iType = SQLITE_NULL;
+				pQuery->nRows++; // so the cells copied so far get freed
+				return false;
+			}
+			break;
+		}
+	}
+	pQuery->nRows++;
+	return true;
+}
+
+static gpointer
+PxQuery_Run(gpointer gUserData)
+// worker thread
+{
+	PxQuery* pQuery = (PxQuery*)gUserData;
+	sqlite3* pDb = NULL;
+	sqlite3_stmt* pStmt = NULL;
+	int iResult;
+
+	iResult = sqlite3_open_v2(pQuery->sDatabase, &pDb, SQLITE_OPEN_READONLY, NULL);
+	if (iResult == SQLITE_OK) {
+		sqlite3_busy_timeout(pDb, TIMEOUT * 1000);
+		sqlite3_progress_handler(pDb, 1000, PxQuery_ProgressCB, pQuery);
+		iResult = sqlite3_prepare_v2(pDb, pQuery->sSQL, -1, &pStmt, NULL);
+	}
+	if (iResult == SQLITE_OK)
+		iResult = PxQuery_Bind(pQuery, pStmt);
+	if (iResult == SQLITE_OK && !PxQuery_DescribeColumns(pQuery, pStmt))
+		iResult = SQLITE_NOMEM;
+
+	if (iResult == SQLITE_OK) {
+		while ((iResult = sqlite3_step(pStmt)) == SQLITE_ROW && !g_atomic_int_get(&pQuery->iCancelled)) {
+			if (!PxQuery_AppendRow(pQuery, pStmt)) {
+				iResult = SQLITE_NOMEM;
+				break;
+			}
+		}
+	}
+
+	if (iResult != SQLITE_DONE && pQuery->sError == NULL)
+		pQuery->sError = PxQuery_StrDup(pDb ? sqlite3_errmsg(pDb) : sqlite3_errstr(iResult), -1);
+	pQuery->iResult = iResult;
+	sqlite3_finalize(pStmt);
+	sqlite3_close(pDb);
+
+	g_idle_add(pQuery->pDoneCB, pQuery);
+	return NULL;
+}
+
+bool
+PxQuery_Start(PxQuery* pQuery, GSourceFunc pDoneCB, gpointer pUserData)
+// pDoneCB will be called with pQuery on the main loop when the worker is done, also if it failed or has been cancelled
+{
+	GThread* gThread;
+	pQuery->pDoneCB = pDoneCB;
+	pQuery->pUserData = pUserData;
+	if ((gThread = g_thread_try_new("PxQuery", PxQuery_Run, pQuery, NULL)) == NULL) {
+		PyErr_SetString(PyExc_RuntimeError, "Can not start query thread.");
+		return false;
+	}
+	g_thread_unref(gThread);
+	return true;
+}
+
+void
+PxQuery_Cancel(PxQuery* pQuery)
+{
+	g_atomic_int_set(&pQuery->iCancelled, 1);
+}
+
+PyObject* // new ref
+PxQuery_GetColumnName(PxQuery* pQuery, int nColumn)
+{
+	return PyUnicode_FromString(pQuery->psColumnNames[nColumn]);
+}
+
+PyObject* // new ref
+PxQuery_GetRow(PxQuery* pQuery, Py_ssize_t nRow)
+// tuple of the row as a sqlite3 cursor would return it
+{
+	PyObject* pyRowData, *pyData, *pyBytes;
+	PxQueryValue* pCell = pQuery->pCells + nRow * pQuery->nColumns;
+	int nColumn;
+
+	if ((pyRowData = PyTuple_New(pQuery->nColumns)) == NULL)
+		return NULL;
+
+	for (nColumn = 0; nColumn < pQuery->nColumns; nColumn++, pCell++) {
+		switch (pCell->iType) {
+		case SQLITE_INTEGER:
+			pyData = PyLong_FromLongLong(pCell->v.i);
+			break;
+		case SQLITE_FLOAT:
+			pyData = PyFloat_FromDouble(pCell->v.f);
+			break;
+		case SQLITE_TEXT:
+			pyData = PyUnicode_DecodeUTF8(pCell->v.b.s, pCell->v.b.n, NULL);
+			break;
+		case SQLITE_BLOB:
+			pyData = PyBytes_FromStringAndSize(pCell->v.b.s, pCell->v.b.n);
+			if (pyData && pQuery->piConverters[nColumn] != -1) {
+				pyBytes = pyData;
+				pyData = PyObject_CallFunctionObjArgs(PyTuple_GET_ITEM(pQuery->pyConverters, pQuery->piConverters[nColumn]), pyBytes, NULL);
+				Py_DECREF(pyBytes);
+			}
+			break;
+		default:
+			Py_INCREF(Py_None);
+			pyData = Py_None;
+		}
+		if (pyData == NULL) {
+			Py_DECREF(pyRowData);
+			return NULL;
+		}
+		PyTuple_SET_ITEM(pyRowData, nColumn, pyData);
+	}
+	return pyRowData;
+}
+
+// Statements on the main thread
+// Prepared on the handle of a sqlite3 module connection, so they share its transaction and no Python cursor sits in between.
+
+static bool
+PxQuery_SameLibrary(void)
+// whether the sqlite3 module runs on the very SQLite library linked here, a handle of another copy must not be used with these functions
+{
+	static int iSame = -1;
+	PyObject* pyModule, *pyFile = NULL, *pyVersion;
+	void* pLibrary;
+
+	if (iSame != -1)
+		return iSame;
+	iSame = 0;
+	if ((pyVersion = PyObject_GetAttrString(g.pySQLiteModule, "sqlite_version")) != NULL) {
+		if (PyUnicode_Check(pyVersion) && strcmp(PyUnicode_AsUTF8(pyVersion), sqlite3_libversion()) == 0 &&
+			(pyModule = PyImport_ImportModule("_sqlite3")) != NULL) {
+			pyFile = PyObject_GetAttrString(pyModule, "__file__");
+			Py_DECREF(pyModule);
+		}
+		Py_DECREF(pyVersion);
+	}
+	// the extension module resolves the library function to this one only if it is linked to the same shared library
+	if (pyFile && PyUnicode_Check(pyFile) && (pLibrary = dlopen(PyUnicode_AsUTF8(pyFile), RTLD_LAZY | RTLD_NOLOAD)) != NULL) {
+		iSame = dlsym(pLibrary, "sqlite3_libversion") == (void*)sqlite3_libversion;
+		dlclose(pLibrary);
+	}
+	Py_XDECREF(pyFile);
+	PyErr_Clear();
+	return iSame;
+}
+
+sqlite3*
+PxQuery_Handle(PyObject* pyConnection)
+// the handle of an open sqlite3 module connection, NULL with an exception if there is none or it belongs to another SQLite library
+{
+	PyObject* pyConnectionType;
+	int iResult;
+
+	if (!PxQuery_SameLibrary()) {
+		PyErr_Format(PyExc_RuntimeError, "Direct access needs the sqlite3 module to run on the SQLite %s library linked here.", sqlite3_libversion());
+		return NULL;
+	}
+	if ((pyConnectionType = PyObject_GetAttrString(g.pySQLiteModule, "Connection")) == NULL)
+		return NULL;
+	iResult = PyObject_IsInstance(pyConnection, pyConnectionType);
+	Py_DECREF(pyConnectionType);
+	if (iResult == -1)
+		return NULL;
+	if (iResult == 0) {
+		PyErr_Format(PyExc_TypeError, "Direct access needs a SQLite connection, not '%.200s'.", Py_TYPE(pyConnection)->tp_name);
+		return NULL;
+	}
+	if (((PxSQLiteConnection*)pyConnection)->db == NULL) {
+		PyErr_SetString(PyExc_ValueError, "Cannot operate on a closed database.");
+		return NULL;
+	}
+	return ((PxSQLiteConnection*)pyConnection)->db;
+}
+
+void
+PxQuery_SetError(PxQuery* pQuery, int iResult)
+// raise the exception the sqlite3 module would for a failed call on pStmt
+{
+	PyObject* pyError;
+	const char* sError;
+
+	if ((iResult & 0xff) == SQLITE_NOMEM) {
+		PyErr_NoMemory();
+		return;
+	}
+	sError = pQuery->sError ? pQuery->sError : sqlite3_errmsg(pQuery->pDb);
+	if ((pyError = PyObject_GetAttrString(g.pySQLiteModule, (iResult & 0xff) == SQLITE_CONSTRAINT ? "IntegrityError" : (iResult & 0xff) == SQLITE_RANGE ? "ProgrammingError" : "OperationalError")) == NULL)
+		return;
+	PyErr_SetString(pyError, sError);
+	Py_DECREF(pyError);
+}
+
+PxQuery*
+PxQuery_Prepare(sqlite3* pDb, PyObject* pyQuery, PyObject* pyParameters)
+// compile on the connection's handle, pyParameters NULL leaves binding to PxQuery_BindValue
+{
+	PxQuery* pQuery;
+	int iResult;
+
+	if ((pQuery = PxQuery_New(NULL, pyQuery, pyParameters)) == NULL)
+		return NULL;
+	pQuery->pDb = pDb;
+	iResult = sqlite3_prepare_v2(pDb, pQuery->sSQL, -1, &pQuery->pStmt, NULL);
+	if (iResult == SQLITE_OK && pyParameters)
+		iResult = PxQuery_Bind(pQuery, pQuery->pStmt);
+	if (iResult == SQLITE_OK && !PxQuery_DescribeColumns(pQuery, pQuery->pStmt))
+		iResult = SQLITE_NOMEM;
+	if (iResult != SQLITE_OK) {
+		PxQuery_SetError(pQuery, iResult);
+		PxQuery_Free(pQuery);
+		return NULL;
+	}
+	return pQuery;
+}
+
+int
+PxQuery_Step(PxQuery* pQuery)
+// SQLITE_ROW or SQLITE_DONE, -1 with an exception if the statement failed
+{
+	int iResult = sqlite3_step(pQuery->pStmt);
+	if (iResult == SQLITE_ROW || iResult == SQLITE_DONE)
+		return iResult;
+	PxQuery_SetError(pQuery, iResult);
+	return -1;
+}
+
+void
+PxQuery_Reset(PxQuery* pQuery)
+// ready to be bound and stepped again, the error of the last step has been reported already
+{
+	sqlite3_reset(pQuery->pStmt);
+	sqlite3_clear_bindings(pQuery->pStmt);
+}
+
+bool
+PxQuery_BindValue(PxQuery* pQuery, int nParam, PyObject* pyData)
+// bind to the parameter at nParam, counting from 1, the way the sqlite3 module would
+{
+	PxQueryValue value;
+	const char* sText;
+	Py_ssize_t nLength;
+	int iResult;
+
+	if (pyData == Py_None)
+		iResult = sqlite3_bind_null(pQuery->pStmt, nParam);
+	else if (PyFloat_CheckExact(pyData))
+		iResult = sqlite3_bind_double(pQuery->pStmt, nParam, PyFloat_AS_DOUBLE(pyData));
+	else if (PyUnicode_CheckExact(pyData)) {
+		if ((sText = PyUnicode_AsUTF8AndSize(pyData, &nLength)) == NULL)
+			return false;
+		iResult = sqlite3_bind_text(pQuery->pStmt, nParam, sText, (int)nLength, SQLITE_TRANSIENT);
+	}
+	else {
+		// integers checked for overflow, dates through the adapters
+		if (!PxQuery_SetValue(&value, pyData))
+			return false;
+		switch (value.iType) {
+		case SQLITE_INTEGER:
+			iResult = sqlite3_bind_int64(pQuery->pStmt, nParam, value.v.i);
+			break;
+		case SQLITE_FLOAT:
+			iResult = sqlite3_bind_double(pQuery->pStmt, nParam, value.v.f);
+			break;
+		case SQLITE_TEXT:
+			iResult = sqlite3_bind_text(pQuery->pStmt, nParam, value.v.b.s, value.v.b.n, SQLITE_TRANSIENT);
+			PyMem_RawFree(value.v.b.s);
+			break;
+		case SQLITE_BLOB:
+			iResult = sqlite3_bind_blob(pQuery->pStmt, nParam, value.v.b.s, value.v.b.n, SQLITE_TRANSIENT);
+			PyMem_RawFree(value.v.b.s);
+			break;
+		default:
+			iResult = sqlite3_bind_null(pQuery->pStmt, nParam);
+		}
+	}
+	if (iResult != SQLITE_OK) {
+		PxQuery_SetError(pQuery, iResult);
+		return false;
+	}
+	return true;
+}
+
+PyObject* // new ref
+PxQuery_ColumnValue(PxQuery* pQuery, int nColumn)
+// cell of the row pStmt is on, as a sqlite3 cursor would return it
+{
+	PyObject* pyData, *pyBytes;
+	const void* pData;
+
+	switch (sqlite3_column_type(pQuery->pStmt, nColumn)) {
+	case SQLITE_NULL:
+		Py_RETURN_NONE;
+	case SQLITE_INTEGER:
+		if (pQuery->piConverters[nColumn] == -1)
+			return PyLong_FromLongLong(sqlite3_column_int64(pQuery->pStmt, nColumn));
+		break;
+	case SQLITE_FLOAT:
+		if (pQuery->piConverters[nColumn] == -1)
+			return PyFloat_FromDouble(sqlite3_column_double(pQuery->pStmt, nColumn));
+		break;
+	case SQLITE_TEXT:
+		if (pQuery->piConverters[nColumn] == -1) {
+			pData = sqlite3_column_text(pQuery->pStmt, nColumn);
+			return PyUnicode_DecodeUTF8(pData ? (const char*)pData : "", sqlite3_column_bytes(pQuery->pStmt, nColumn), NULL);
+		}
+		break;
+	}
+
+	// converters get the raw bytes
+	pData = sqlite3_column_blob(pQuery->pStmt, nColumn);
+	if ((pyData = PyBytes_FromStringAndSize(pData ? (const char*)pData : "", sqlite3_column_bytes(pQuery->pStmt, nColumn))) == NULL)
+		return NULL;
+	if (pQuery->piConverters[nColumn] != -1) {
+		pyBytes = pyData;
+		pyData = PyObject_CallFunctionObjArgs(PyTuple_GET_ITEM(pQuery->pyConverters, pQuery->piConverters[nColumn]), pyBytes, NULL);
+		Py_DECREF(pyBytes);
+	}
+	return pyData;
+}
+
+PyObject* // new ref
+PxQuery_GetStatementRow(PxQuery* pQuery)
+// tuple of the row pStmt is on
+{
+	PyObject* pyRowData, *pyData;
+	int nColumn;
+
+	if ((pyRowData = PyTuple_New(pQuery->nColumns)) == NULL)
+		return NULL;
+	for (nColumn = 0; nColumn < pQuery->nColumns; nColumn++) {
+		if ((pyData = PxQuery_ColumnValue(pQuery, nColumn)) == NULL) {
+			Py_DECREF(pyRowData);
+			return NULL;
+		}
+		PyTuple_SET_ITEM(pyRowData, nColumn, pyData);
+	}
+	return pyRowData;
+}
+
+static void
+PxQuery_FreeValues(PxQueryValue* pValues, Py_ssize_t nValues)
+{
+	Py_ssize_t n;
+	for (n = 0; n < nValues; n++)
+		if (pValues[n].iType == SQLITE_TEXT || pValues[n].iType == SQLITE_BLOB)
+			PyMem_RawFree(pValues[n].v.b.s);
+	PyMem_RawFree(pValues);
+}
+
+void
+PxQuery_Free(PxQuery* pQuery)
+// on the main thread, after the worker has finished
+{
+	int n;
+
+	if (pQuery == NULL)
+		return;
+	sqlite3_finalize(pQuery->pStmt);
+	PyMem_RawFree(pQuery->sDatabase);
+	PyMem_RawFree(pQuery->sSQL);
+	if (pQuery->psParamNames)
+		for (n = 0; n < pQuery->nParams; n++)
+			PyMem_RawFree(pQuery->psParamNames[n]);
+	PyMem_RawFree(pQuery->psParamNames);
+	if (pQuery->pParams)
+		PxQuery_FreeValues(pQuery->pParams, pQuery->nParams);
+	if (pQuery->psConverters)
+		for (n = 0; n < pQuery->nConverters; n++)
+			PyMem_RawFree(pQuery->psConverters[n]);
+	PyMem_RawFree(pQuery->psConverters);
+	Py_XDECREF(pQuery->pyConverters);
+	if (pQuery->psColumnNames)
+		for (n = 0; n < pQuery->nColumns; n++)
+			PyMem_RawFree(pQuery->psColumnNames[n]);
+	PyMem_RawFree(pQuery->psColumnNames);
+	PyMem_RawFree(pQuery->piConverters);
+	if (pQuery->pCells)
+		PxQuery_FreeValues(pQuery->pCells, pQuery->nRows * pQuery->nColumns);
+	PyMem_RawFree(pQuery->sError);
+	PyMem_RawFree(pQuery);
+}
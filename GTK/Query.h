@@ -0,0 +1,72 @@
+﻿// Query.h  | Pylax © 2017 by Thomas Führinger
+#ifndef Px_QUERY_H
+#define Px_QUERY_H
+
+// A query run on a worker thread through the SQLite C API.
+// The worker never touches a Python object: parameters are converted before it starts and rows after it has finished, both on the main thread.
+// A query prepared on the handle of a sqlite3 module connection instead is stepped on the main thread, inside the connection's transaction.
+// That handle is only taken if the module runs on the very SQLite library linked here, see PxQuery_Handle.
+
+typedef struct _PxSQLiteConnection // head of pysqlite_Connection, from Python-3.11\Modules\_sqlite\connection.h
+{
+	PyObject_HEAD
+	sqlite3* db;            // NULL once closed
+}
+PxSQLiteConnection;
+
+typedef struct _PxQueryValue
+{
+	int iType;              // SQLITE_INTEGER, SQLITE_FLOAT, SQLITE_TEXT, SQLITE_BLOB or SQLITE_NULL
+	union {
+		sqlite3_int64 i;
+		double f;
+		struct {
+			char* s;        // on the heap
+			int n;
+		} b;
+	} v;
+}
+PxQueryValue;
+
+typedef struct _PxQuery
+{
+	char* sDatabase;        // file name, NULL if prepared on a connection's handle
+	sqlite3* pDb;           // the connection's handle, for pStmt
+	sqlite3_stmt* pStmt;    // prepared by PxQuery_Prepare, NULL for a worker query
+	char* sSQL;
+	int nParams;
+	char** psParamNames;    // without ':', NULL if parameters are positional
+	PxQueryValue* pParams;
+	int nConverters;
+	char** psConverters;    // names of the converters registered with the sqlite3 module, upper case
+	PyObject* pyConverters; // tuple of the converter functions, same order
+	int nColumns;
+	char** psColumnNames;   // as cursor.description would report them
+	int* piConverters;      // index into psConverters for each column, -1 if none applies
+	Py_ssize_t nRows;
+	Py_ssize_t nCapacity;
+	PxQueryValue* pCells;   // nColumns per row
+	int iResult;            // SQLITE_DONE if all rows have been read
+	char* sError;
+	gint iCancelled;        // the result is not wanted any more
+	GSourceFunc pDoneCB;    // called on the main loop with the query once the worker has finished
+	gpointer pUserData;     // for pDoneCB
+}
+PxQuery;
+
+PxQuery* PxQuery_New(const char* sDatabase, PyObject* pyQuery, PyObject* pyParameters);
+bool PxQuery_Start(PxQuery* pQuery, GSourceFunc pDoneCB, gpointer pUserData);
+sqlite3* PxQuery_Handle(PyObject* pyConnection);
+PxQuery* PxQuery_Prepare(sqlite3* pDb, PyObject* pyQuery, PyObject* pyParameters);
+int PxQuery_Step(PxQuery* pQuery);
+void PxQuery_Reset(PxQuery* pQuery);
+bool PxQuery_BindValue(PxQuery* pQuery, int nParam, PyObject* pyData);
+PyObject* PxQuery_ColumnValue(PxQuery* pQuery, int nColumn);
+PyObject* PxQuery_GetStatementRow(PxQuery* pQuery);
+void PxQuery_SetError(PxQuery* pQuery, int iResult);
+void PxQuery_Cancel(PxQuery* pQuery);
+PyObject* PxQuery_GetColumnName(PxQuery* pQuery, int nColumn);
+PyObject* PxQuery_GetRow(PxQuery* pQuery, Py_ssize_t nRow);
+void PxQuery_Free(PxQuery* pQuery);
+
+#endif
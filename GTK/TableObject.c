@@ -7,6 +7,7 @@ static void GtkTreeSelection_ChangedCB(GtkTreeSelection* gtkTreeSelection, gpoin
 static void GtkCellRenderer_TextEditedCB(GtkCellRendererText* gtkCellRendererText, GtkTreePath* gtkTreePath, gchar* sText, gpointer gUserData);
 static void GtkCellRenderer_EditingStartedCB(GtkCellRendererText* gtkCellRendererText, GtkCellEditable* gtkCellEditable, const gchar* sPath, gpointer gUserData);
 static gboolean GtkTreeView_FocusInEventCB(GtkWidget* gtkWidget, GdkEvent* gdkEvent, gpointer gUserData);
+static void GtkTreeViewColumn_ClickedCB(GtkTreeViewColumn* gtkTreeViewColumn, gpointer gUserData);
 
 static PyObject *
 PxTable_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
@@ -18,6 +19,9 @@ PxTable_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
 		self->bShowRecordIndicator = false;
 		self->nColumns = 0;
 		self->iAutoSizeColumn = -1;
+		self->iSortColumn = -1;
+		self->bSortDescending = false;
+		self->bMultiSelect = false;
 		self->pyColumns = PyList_New(0);
 		return (PyObject*)self;
 	}
@@ -170,6 +174,10 @@ PxTable_add_column(PxTableObject* self, PyObject* args, PyObject* kwds)
 	gtk_tree_view_column_set_cell_data_func(gtkTreeViewColumn, pyColumn->gtkCellRenderer, GtkTreeCell_Render, pyColumn, NULL);
 	gtk_tree_view_column_set_resizable(gtkTreeViewColumn, TRUE);
 	g_object_set(gtkTreeViewColumn, "sizing", GTK_TREE_VIEW_COLUMN_FIXED, NULL);
+	if (pyDynasetColumn) {
+		gtk_tree_view_column_set_clickable(gtkTreeViewColumn, TRUE);
+		g_signal_connect(G_OBJECT(gtkTreeViewColumn), "clicked", G_CALLBACK(GtkTreeViewColumn_ClickedCB), pyColumn);
+	}
 	/*gint iIndex = */gtk_tree_view_append_column(self->gtkTreeView, gtkTreeViewColumn);
 	pyColumn->gtkTreeViewColumn = gtkTreeViewColumn;
 
@@ -179,6 +187,25 @@ PxTable_add_column(PxTableObject* self, PyObject* args, PyObject* kwds)
 	return (PyObject*)pyColumn;
 }
 
+static void
+PxTable_ShowSelection(PxTableObject* self)
+// select the rows selected in the Dynaset, or its current row if there are none; the caller blocks the changed signal
+{
+	PxDynasetObject* pyDynaset = self->pyDynaset;
+	GtkTreePath* gtkTreePath;
+	Py_ssize_t n, nPosition;
+
+	gtk_tree_selection_unselect_all(self->gtkTreeSelection);
+	for (n = 0; n < (pyDynaset->nSelected ? pyDynaset->nSelected : 1); n++) {
+		nPosition = PxDynaset_ViewPosition(pyDynaset, pyDynaset->nSelected ? pyDynaset->pnSelected[n] : pyDynaset->nRow);
+		if (nPosition == -1)
+			continue;
+		gtkTreePath = gtk_tree_path_new_from_indices((gint)nPosition, -1);
+		gtk_tree_selection_select_path(self->gtkTreeSelection, gtkTreePath);
+		gtk_tree_path_free(gtkTreePath);
+	}
+}
+
 static PyObject *
 PxTable_refresh(PxTableObject* self)
 {
@@ -192,21 +219,129 @@ PxTable_refresh(PxTableObject* self)
 	g_signal_handler_block(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
 	gtk_list_store_clear(self->gtkListStore);
 
-    if (self->pyDynaset->nRows >0) {
-	for (iRow = 0; iRow < self->pyDynaset->nRows; iRow++) {
+    if (PxDynaset_ViewRows(self->pyDynaset) > 0) {
+	// each list store row holds the number of the Dynaset row it shows
+	for (iRow = 0; iRow < PxDynaset_ViewRows(self->pyDynaset); iRow++) {
 		gtk_list_store_append(self->gtkListStore, &gtkTreeIter);
-		gtk_list_store_set(self->gtkListStore, &gtkTreeIter, 0, iRow, -1);
+		gtk_list_store_set(self->gtkListStore, &gtkTreeIter, 0, (gint)PxDynaset_ViewRow(self->pyDynaset, iRow), -1);
 	}
 
-	gtkTreePath = gtk_tree_path_new_from_indices(self->pyDynaset->nRow, -1);
-	gtk_tree_selection_select_path(self->gtkTreeSelection, gtkTreePath);
-	gtk_tree_path_free(gtkTreePath);
+	if (self->bMultiSelect)
+		PxTable_ShowSelection(self);
+	else if (PxDynaset_ViewPosition(self->pyDynaset, self->pyDynaset->nRow) != -1) {
+		gtkTreePath = gtk_tree_path_new_from_indices((gint)PxDynaset_ViewPosition(self->pyDynaset, self->pyDynaset->nRow), -1);
+		gtk_tree_selection_select_path(self->gtkTreeSelection, gtkTreePath);
+		gtk_tree_path_free(gtkTreePath);
+	}
 	}
 	g_signal_handler_unblock(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
 
 	Py_RETURN_TRUE;
 }
 
+static PyObject *
+PxTable_append_rows(PxTableObject* self, PyObject* args)
+{
+	Py_ssize_t nRow;
+	gint iRow;
+	GtkTreeIter gtkTreeIter;
+
+	if (!PyArg_ParseTuple(args, "n", &nRow)) {
+		return NULL;
+	}
+
+	// rows already in the list store stay untouched, so selection and scroll position are kept
+	iRow = gtk_tree_model_iter_n_children(GTK_TREE_MODEL(self->gtkListStore), NULL);
+	if (iRow < nRow)
+		iRow = (gint)nRow;
+	for (; iRow < PxDynaset_ViewRows(self->pyDynaset); iRow++) {
+		gtk_list_store_append(self->gtkListStore, &gtkTreeIter);
+		gtk_list_store_set(self->gtkListStore, &gtkTreeIter, 0, (gint)PxDynaset_ViewRow(self->pyDynaset, iRow), -1);
+	}
+	Py_RETURN_TRUE;
+}
+
+static void
+PxTable_ShiftRows(PxTableObject* self, Py_ssize_t nFirst, Py_ssize_t nDelta)
+// the Dynaset has inserted nDelta rows before row nFirst or, if negative, removed rows from nFirst on; the rows in sight stay where they are
+{
+	GtkTreeModel* gtkTreeModel = GTK_TREE_MODEL(self->gtkListStore);
+	GtkTreeIter gtkTreeIter;
+	GtkTreePath* gtkStartPath, *gtkEndPath;
+	gint iRow, iPosition, iTop = -1, iTopShift = 0, iInsertAt = -1;
+	gboolean bValid;
+	Py_ssize_t n;
+
+	g_signal_handler_block(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+	if (gtk_tree_view_get_visible_range(self->gtkTreeView, &gtkStartPath, &gtkEndPath)) {
+		iTop = gtk_tree_path_get_indices(gtkStartPath)[0];
+		gtk_tree_path_free(gtkStartPath);
+		gtk_tree_path_free(gtkEndPath);
+	}
+
+	// list store rows hold Dynaset row numbers in ascending order
+	bValid = gtk_tree_model_get_iter_first(gtkTreeModel, &gtkTreeIter);
+	for (iPosition = 0; bValid; iPosition++) {
+		gtk_tree_model_get(gtkTreeModel, &gtkTreeIter, 0, &iRow, -1);
+		if (iRow < nFirst) {
+			bValid = gtk_tree_model_iter_next(gtkTreeModel, &gtkTreeIter);
+			continue;
+		}
+		if (iInsertAt == -1)
+			iInsertAt = iPosition;
+		if (nDelta < 0 && iRow < nFirst - nDelta) {
+			if (iPosition < iTop)
+				iTopShift--;
+			bValid = gtk_list_store_remove(self->gtkListStore, &gtkTreeIter);
+			continue;
+		}
+		gtk_list_store_set(self->gtkListStore, &gtkTreeIter, 0, (gint)(iRow + nDelta), -1);
+		bValid = gtk_tree_model_iter_next(gtkTreeModel, &gtkTreeIter);
+	}
+
+	if (nDelta > 0) {
+		if (iInsertAt == -1)
+			iInsertAt = iPosition;
+		for (n = 0; n < nDelta; n++) {
+			gtk_list_store_insert(self->gtkListStore, &gtkTreeIter, iInsertAt + (gint)n);
+			gtk_list_store_set(self->gtkListStore, &gtkTreeIter, 0, (gint)(nFirst + n), -1);
+		}
+		if (iInsertAt <= iTop)
+			iTopShift += (gint)nDelta;
+	}
+
+	if (iTop != -1 && iTopShift != 0) {
+		gtkStartPath = gtk_tree_path_new_from_indices(iTop + iTopShift > 0 ? iTop + iTopShift : 0, -1);
+		gtk_tree_view_scroll_to_cell(self->gtkTreeView, gtkStartPath, NULL, TRUE, 0.0, 0.0);
+		gtk_tree_path_free(gtkStartPath);
+	}
+	g_signal_handler_unblock(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+}
+
+static PyObject *
+PxTable_insert_rows(PxTableObject* self, PyObject* args)
+{
+	Py_ssize_t nRow, nCount;
+
+	if (!PyArg_ParseTuple(args, "nn", &nRow, &nCount)) {
+		return NULL;
+	}
+	PxTable_ShiftRows(self, nRow, nCount);
+	Py_RETURN_TRUE;
+}
+
+static PyObject *
+PxTable_remove_rows(PxTableObject* self, PyObject* args)
+{
+	Py_ssize_t nRow, nCount;
+
+	if (!PyArg_ParseTuple(args, "nn", &nRow, &nCount)) {
+		return NULL;
+	}
+	PxTable_ShiftRows(self, nRow, -nCount);
+	Py_RETURN_TRUE;
+}
+
 static PyObject *
 PxTable_refresh_cell(PxTableObject* self, PyObject* args)
 {
@@ -220,11 +355,14 @@ PxTable_refresh_cell(PxTableObject* self, PyObject* args)
 		return NULL;
 	}
 
-	gtkTreePath = gtk_tree_path_new_from_indices(nRow, -1);
+	if (PxDynaset_ViewPosition(self->pyDynaset, nRow) == -1) // filtered out
+		Py_RETURN_TRUE;
+	gtkTreePath = gtk_tree_path_new_from_indices((gint)PxDynaset_ViewPosition(self->pyDynaset, nRow), -1);
 	if (!gtk_tree_model_get_iter(self->gtkListStore, &gtkTreeIter, gtkTreePath))
 		g_debug("Non-existing path in Table");
 	//return; /* path describes a non-existing row - should not happen */
 	gtk_list_store_set(self->gtkListStore, &gtkTreeIter, 0, nRow, -1);  // set it to the same value just to trigger an update of the tree view
+	gtk_tree_path_free(gtkTreePath);
 	//g_object_unref(gtkTreePath);
 
 	//g_debug("PxTable_refresh_cell x");
@@ -238,8 +376,26 @@ PxTable_refresh_row_pointer(PxTableObject* self, PyObject* args)
 	GtkTreeIter   gtkTreeIter;
 	gint iRow;
 	GtkTreePath* gtkTreePath;
+	gboolean bSelected;
 	//g_debug("PxTable_refresh_row_pointer");
 
+	if (self->bMultiSelect) {
+		// the current row stays among the rows selected, if it is not it becomes the only one
+		if (PxDynaset_ViewPosition(self->pyDynaset, self->pyDynaset->nRow) == -1)
+			Py_RETURN_NONE;
+		gtkTreePath = gtk_tree_path_new_from_indices((gint)PxDynaset_ViewPosition(self->pyDynaset, self->pyDynaset->nRow), -1);
+		bSelected = gtk_tree_selection_path_is_selected(self->gtkTreeSelection, gtkTreePath);
+		gtk_tree_path_free(gtkTreePath);
+		if (bSelected)
+			Py_RETURN_NONE;
+		if (!PxDynaset_Select(self->pyDynaset, &self->pyDynaset->nRow, 1, (PxWidgetObject*)self))
+			return NULL;
+		g_signal_handler_block(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+		PxTable_ShowSelection(self);
+		g_signal_handler_unblock(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+		Py_RETURN_NONE;
+	}
+
 	if (gtk_tree_selection_get_selected(self->gtkTreeSelection, &gtkTreeModel, &gtkTreeIter))
 	{
 		gtk_tree_model_get(gtkTreeModel, &gtkTreeIter, 0, &iRow, -1);
@@ -253,17 +409,28 @@ PxTable_refresh_row_pointer(PxTableObject* self, PyObject* args)
 
 	if (self->pyDynaset->nRow == iRow)
 		Py_RETURN_NONE;
-	if (self->pyDynaset->nRow == -1) {
+	if (PxDynaset_ViewPosition(self->pyDynaset, self->pyDynaset->nRow) == -1) { // no row or filtered out
 		gtk_tree_selection_unselect_all(self->gtkTreeSelection);
+		Py_RETURN_NONE;
 	}
 
-	gtkTreePath = gtk_tree_path_new_from_indices(self->pyDynaset->nRow, -1);
+	gtkTreePath = gtk_tree_path_new_from_indices((gint)PxDynaset_ViewPosition(self->pyDynaset, self->pyDynaset->nRow), -1);
 	gtk_tree_selection_select_path(self->gtkTreeSelection, gtkTreePath);
 	gtk_tree_path_free(gtkTreePath);
 	//g_debug("PxTable_refresh_row_pointer done");
 	Py_RETURN_NONE;
 }
 
+static PyObject*
+PxTable_refresh_selection(PxTableObject* self)
+{
+	if (self->bMultiSelect) {
+		g_signal_handler_block(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+		PxTable_ShowSelection(self);
+		g_signal_handler_unblock(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+	}
+	Py_RETURN_TRUE;
+}
 
 static PyObject*  // new ref, True if possible to move focus away
 PxTable_render_focus(PxTableObject* self)
@@ -295,6 +462,15 @@ PxTable_setattro(PxTableObject* self, PyObject* pyAttributeName, PyObject* pyVal
 			}*/
 			return 0;
 		}
+		if (PyUnicode_CompareWithASCIIString(pyAttributeName, "multiSelect") == 0) {
+			self->bMultiSelect = PyObject_IsTrue(pyValue);
+			g_signal_handler_block(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+			gtk_tree_selection_set_mode(self->gtkTreeSelection, self->bMultiSelect ? GTK_SELECTION_MULTIPLE : GTK_SELECTION_SINGLE);
+			g_signal_handler_unblock(G_OBJECT(self->gtkTreeSelection), self->gtkTreeSelectionChangedHandlerID);
+			if (!self->bMultiSelect && !PxDynaset_Select(self->pyDynaset, NULL, 0, (PxWidgetObject*)self))
+				return -1;
+			return 0;
+		}
 	}
 	return PxTableType.tp_base->tp_setattro((PyObject*)self, pyAttributeName, pyValue);
 }
@@ -315,7 +491,11 @@ static PyMethodDef PxTable_methods[] = {
 	{ "add_column", (PyCFunction)PxTable_add_column, METH_VARARGS | METH_KEYWORDS, "Add a column" },
 	{ "refresh", (PyCFunction)PxTable_refresh, METH_NOARGS, "Pull fresh data" },
 	{ "refresh_cell", (PyCFunction)PxTable_refresh_cell, METH_VARARGS, "Pull fresh data one cell" },
+	{ "append_rows", (PyCFunction)PxTable_append_rows, METH_VARARGS, "Show rows the Dynaset has loaded from the given row on" },
+	{ "insert_rows", (PyCFunction)PxTable_insert_rows, METH_VARARGS, "Show count rows the Dynaset has inserted before the given row" },
+	{ "remove_rows", (PyCFunction)PxTable_remove_rows, METH_VARARGS, "Drop count rows the Dynaset has removed from the given row on" },
 	{ "refresh_row_pointer", (PyCFunction)PxTable_refresh_row_pointer, METH_NOARGS, "Update highlight of selected row" },
+	{ "refresh_selection", (PyCFunction)PxTable_refresh_selection, METH_NOARGS, "Highlight the rows selected in the Dynaset, if multiSelect is set" },
 	{ "render_focus", (PyCFunction)PxTable_render_focus, METH_NOARGS, "Return True if ready for focus to move on." },
 	{ NULL }
 };
@@ -376,9 +556,18 @@ GtkTreeCell_Render(GtkTreeViewColumn* gtkTreeViewColumn, GtkCellRenderer* gtkCel
 		gtk_tree_model_get(gtkTreeModel, gtkTreeIter, 0, &iRow, -1);
 		pyTableColumn = (PxTableColumnObject*)gUserData;
 		pyDynasetColumn = pyTableColumn->pyDynasetColumn;
+
+		// scrolled close to the last loaded row, have the Dynaset pull the next window
+		PxDynasetObject* pyDynaset = pyTableColumn->pyTable->pyDynaset;
+		if (!pyDynaset->bFetchComplete && (Py_ssize_t)iRow + pyDynaset->nFetchSize / 2 >= pyDynaset->nRows)
+			PxDynaset_RequestFetch(pyDynaset);
+		// or close to the first row of a paged Dynaset's window, have it read the page before
+		else if (!pyDynaset->bPageStart && (Py_ssize_t)iRow < pyDynaset->nFetchSize / 2)
+			PxDynaset_RequestPreviousPage(pyDynaset);
+
 		pyData = PxDynaset_GetData(pyTableColumn->pyTable->pyDynaset, (Py_ssize_t)iRow, pyDynasetColumn);
 
-		if (!(pyText = PxFormatData(pyData, pyTableColumn->pyFormat))) {
+		if (pyData == NULL || !(pyText = PxFormatData(pyData, pyTableColumn->pyFormat))) {
 			sText = "#Error#";
 			PyErr_Print();
 		}
@@ -386,6 +575,7 @@ GtkTreeCell_Render(GtkTreeViewColumn* gtkTreeViewColumn, GtkCellRenderer* gtkCel
 			sText = PyUnicode_AsUTF8(pyText);
 			Py_DECREF(pyText);
 		}
+		Py_XDECREF(pyData);
 
 		//g_object_set(renderer, "foreground-set", FALSE, NULL);
 		//g_object_set(renderer, "foreground", "Red", "foreground-set", TRUE, NULL);
@@ -397,19 +587,19 @@ static void
 GtkTreeCell_RenderRowIndicator(GtkTreeViewColumn* gtkTreeViewColumn, GtkCellRenderer* gtkCellRenderer, GtkTreeModel* gtkTreeModel, GtkTreeIter* gtkTreeIter, gpointer gUserData)
 {
 	guint iRow;
-	PyObject* pyRow;
+	unsigned char cState;
 	PxTableObject* pyTable;
 	char* sText;
 
 	gtk_tree_model_get(gtkTreeModel, gtkTreeIter, 0, &iRow, -1);
 	pyTable = (PxTableObject*)gUserData;
-	pyRow = PyList_GetItem(pyTable->pyDynaset->pyRows, (Py_ssize_t)iRow);
+	cState = PxDynaset_GetRowState(pyTable->pyDynaset, (Py_ssize_t)iRow);
 
-	if (PyStructSequence_GetItem(pyRow, PXDYNASETROW_DELETE) == Py_True)
+	if (cState & PxROW_DELETE)
 		sText = "X"; // †×
-	else if (PyStructSequence_GetItem(pyRow, PXDYNASETROW_NEW) == Py_True)
+	else if (cState & PxROW_NEW)
 		sText = "*"; // ○☼
-	else if (PyStructSequence_GetItem(pyRow, PXDYNASETROW_DATAOLD) != Py_None)
+	else if (cState & PxROW_MODIFIED)
 		sText = "Δ"; // Ҩ
 	else
 		sText = " ";
@@ -417,6 +607,64 @@ GtkTreeCell_RenderRowIndicator(GtkTreeViewColumn* gtkTreeViewColumn, GtkCellRend
 	g_object_set(gtkCellRenderer, "text", sText, NULL);
 }
 
+static void
+GtkTreeViewColumn_ClickedCB(GtkTreeViewColumn* gtkTreeViewColumn, gpointer gUserData)
+// sort the rows by the column, in reverse order if clicked again
+{
+	PxTableColumnObject* self = (PxTableColumnObject*)gUserData;
+	PxTableObject* pyTable = self->pyTable;
+	PxTableColumnObject* pySortColumn;
+	bool bDescending = (pyTable->iSortColumn == self->iIndex) ? !pyTable->bSortDescending : false;
+
+	if (!PxDynaset_Sort(pyTable->pyDynaset, 1, &self->pyDynasetColumn, &bDescending)) {
+		PythonErrorDialog();
+		return;
+	}
+
+	if (pyTable->iSortColumn != -1 && pyTable->iSortColumn != self->iIndex) {
+		pySortColumn = (PxTableColumnObject*)PyList_GetItem(pyTable->pyColumns, pyTable->iSortColumn);
+		gtk_tree_view_column_set_sort_indicator(pySortColumn->gtkTreeViewColumn, FALSE);
+	}
+	pyTable->iSortColumn = self->iIndex;
+	pyTable->bSortDescending = bDescending;
+	gtk_tree_view_column_set_sort_indicator(gtkTreeViewColumn, TRUE);
+	gtk_tree_view_column_set_sort_order(gtkTreeViewColumn, bDescending ? GTK_SORT_DESCENDING : GTK_SORT_ASCENDING);
+}
+
+static void
+PxTable_MultipleSelectionChanged(PxTableObject* self)
+// the Dynaset's selection follows the rows selected, its row pointer the cursor if it is on one of them, else the first of them
+{
+	GList* gList, *gItem;
+	GtkTreePath* gtkCursorPath;
+	Py_ssize_t* pnRows, nCount = 0, nRow = -1;
+	bool bOk;
+
+	gList = gtk_tree_selection_get_selected_rows(self->gtkTreeSelection, NULL);
+	if ((pnRows = (Py_ssize_t*)PyMem_RawMalloc((g_list_length(gList) + 1) * sizeof(Py_ssize_t))) == NULL) {
+		g_list_free_full(gList, (GDestroyNotify)gtk_tree_path_free);
+		PyErr_NoMemory();
+		PythonErrorDialog();
+		return;
+	}
+	for (gItem = gList; gItem; gItem = gItem->next)
+		pnRows[nCount++] = PxDynaset_ViewRow(self->pyDynaset, gtk_tree_path_get_indices((GtkTreePath*)gItem->data)[0]);
+	g_list_free_full(gList, (GDestroyNotify)gtk_tree_path_free);
+	if (nCount > 0)
+		nRow = pnRows[0];
+	gtk_tree_view_get_cursor(self->gtkTreeView, &gtkCursorPath, NULL);
+	if (gtkCursorPath) {
+		if (gtk_tree_selection_path_is_selected(self->gtkTreeSelection, gtkCursorPath))
+			nRow = PxDynaset_ViewRow(self->pyDynaset, gtk_tree_path_get_indices(gtkCursorPath)[0]);
+		gtk_tree_path_free(gtkCursorPath);
+	}
+
+	bOk = PxDynaset_Select(self->pyDynaset, pnRows, nCount, (PxWidgetObject*)self) && PxDynaset_SetRow(self->pyDynaset, nRow);
+	PyMem_RawFree(pnRows);
+	if (!bOk)
+		PythonErrorDialog();
+}
+
 static void
 GtkTreeSelection_ChangedCB(GtkTreeSelection* gtkTreeSelection, gpointer gUserData)
 {
@@ -424,6 +672,10 @@ GtkTreeSelection_ChangedCB(GtkTreeSelection* gtkTreeSelection, gpointer gUserDat
 	GtkTreeModel* gtkTreeModel;
 	gint iRow = -1;
 
+	if (((PxTableObject*)gUserData)->bMultiSelect) {
+		PxTable_MultipleSelectionChanged((PxTableObject*)gUserData);
+		return;
+	}
 	if (gtk_tree_selection_get_selected(gtkTreeSelection, &gtkTreeModel, &gtkTreeIter))
 		gtk_tree_model_get(gtkTreeModel, &gtkTreeIter, 0, &iRow, -1);
 		//Xx("->pyDynaset ",((PxTableObject*)gUserData)->pyDynaset);
@@ -438,7 +690,7 @@ GtkCellRenderer_TextEditedCB(GtkCellRendererText* gtkCellRendererText, GtkTreePa
 	PyObject* pyCurrentData = NULL, *pyNewData = NULL;
 	PxTableColumnObject* self = (PxTableColumnObject*)gUserData;
 	gint* gIndices = gtk_tree_path_get_indices(gtkTreePath);
-	gint iRow = gIndices[0];
+	gint iRow = (gint)PxDynaset_ViewRow(self->pyTable->pyDynaset, gIndices[0]); // path is the position in the view
 	g_debug("iRow %d", iRow);
 
 	int iR = PxWindow_MoveFocus(self->pyTable->pyWindow, (PxWidgetObject*)self);
@@ -450,14 +702,21 @@ GtkCellRenderer_TextEditedCB(GtkCellRendererText* gtkCellRendererText, GtkTreePa
 	if ((pyNewData = PxParseString(sText, self->pyType, NULL)) == NULL)
 		goto ERROR;
 
-	pyCurrentData = PxDynaset_GetData(self->pyTable->pyDynaset, (Py_ssize_t)iRow, self->pyDynasetColumn);
+	if ((pyCurrentData = PxDynaset_GetData(self->pyTable->pyDynaset, (Py_ssize_t)iRow, self->pyDynasetColumn)) == NULL) {
+		Py_DECREF(pyNewData);
+		goto ERROR;
+	}
 	if (PyObject_RichCompareBool(pyCurrentData, pyNewData, Py_EQ)) {
+		Py_DECREF(pyCurrentData);
 		Py_DECREF(pyNewData);
 		pyNewData = NULL;
 		return;
 	}
+	Py_DECREF(pyCurrentData);
 
-	if (PxDynaset_SetData(self->pyTable->pyDynaset, iRow, self->pyDynasetColumn, pyNewData))
+	bool bOk = PxDynaset_SetData(self->pyTable->pyDynaset, iRow, self->pyDynasetColumn, pyNewData);
+	Py_DECREF(pyNewData);
+	if (bOk)
 		return;
 
 ERROR:
@@ -474,20 +733,22 @@ GtkCellRenderer_EditingStartedCB(GtkCellRendererText* gtkCellRendererText, GtkCe
 
 	{
 		GtkEntry* gtkEntry = GTK_ENTRY(gtkCellEditable);
+		PxTableColumnObject* self = (PxTableColumnObject*)gUserData;
 		GtkTreePath* gtkTreePath = gtk_tree_path_new_from_string(sPath);
 		gint* gIndices = gtk_tree_path_get_indices(gtkTreePath);
-		gint iRow = gIndices[0];
-		g_object_unref(gtkTreePath);
+		gint iRow = (gint)PxDynaset_ViewRow(self->pyTable->pyDynaset, gIndices[0]);
+		gtk_tree_path_free(gtkTreePath);
 
-		PxTableColumnObject* self = (PxTableColumnObject*)gUserData;
 		pyCurrentData = PxDynaset_GetData(self->pyTable->pyDynaset, (Py_ssize_t)iRow, self->pyDynasetColumn);
 
 		if (pyCurrentData == NULL || pyCurrentData == Py_None) {
 			gtk_entry_set_text(gtkEntry, "");
+			Py_XDECREF(pyCurrentData);
 			return;
 		}
 
 		PyObject* pyText = PxFormatData(pyCurrentData, self->pyFormatEdit ? self->pyFormatEdit : Py_None);
+		Py_DECREF(pyCurrentData);
 		if (pyText == NULL) {
 			return;
 		}
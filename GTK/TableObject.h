@@ -15,6 +15,9 @@ typedef struct _PxTableObject
 	GtkTreeViewColumn* gtkTreeViewColumnRecordIndicator;
 	GtkCellRenderer* gtkCellRendererRecordIndicator;
 	gulong gtkTreeSelectionChangedHandlerID;
+	int iSortColumn;      // index of the column the rows have been sorted by with a header click, -1 if none
+	bool bSortDescending;
+	bool bMultiSelect;    // rows are selected with Ctrl and Shift, the Dynaset's selection follows
 	//int iFocusRow;
 	//int iFocusColumn;
 }
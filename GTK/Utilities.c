@@ -148,6 +148,19 @@ PyTuple_Duplicate(PyTupleObject* pyTuple)
 	return pyNewTuple;
 }
 
+int
+PxListAppendString(PyObject* pyList, const char* sText)
+// returns 0 on success, -1 on failure like PyList_Append
+{
+	PyObject* pyText = PyUnicode_FromString(sText);
+	int iResult;
+	if (pyText == NULL)
+		return -1;
+	iResult = PyList_Append(pyList, pyText);
+	Py_DECREF(pyText);
+	return iResult;
+}
+
 void
 ErrorDialog(char* sMessage)
 {
@@ -8,6 +8,7 @@ char* StringAppend2(char* sMain, char* sAppex1, char* sAppex2);
 void ErrorDialog(char* sMessage);
 void PythonErrorDialog();
 PyTupleObject* PyTuple_Duplicate(PyTupleObject* pyTuple);
+int PxListAppendString(PyObject* pyList, const char* sText);
 bool PxAttachObject(PyObject** ppyMember, PyObject* pyObject, bool bStrong);
 PyObject* PxFormatData(PyObject* pyData, PyObject* pyFormat);
 PyObject* PxParseString(char* sText, PyTypeObject* pyDataType, PyObject* pyFormat);
@@ -348,12 +348,12 @@ PxWidget_move(PxWidgetObject* self, PyObject* args, PyObject* kwds)
 	Py_RETURN_FALSE;
 }
 
-PyObject* // borrowed ref
+PyObject* // new ref
 PxWidget_PullData(PxWidgetObject* self)
 {
 	if (self->pyDynaset && self->pyDataColumn) {
 		if (self->pyDynaset->nRow == -1)
-			return Py_None;//Py_RETURN_NONE;
+			Py_RETURN_NONE;
 		else
 			return PxDynaset_GetData(self->pyDynaset, self->pyDynaset->nRow, self->pyDataColumn);
 	}